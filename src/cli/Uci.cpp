@@ -0,0 +1,343 @@
+#include "Uci.h"
+
+#include "Bench.h"
+#include "Board.h"
+#include "Fen.h"
+#include "Search.h"
+
+#include <atomic>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+
+static const char* startFen = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+static const int defaultSearchDepth = 6;
+
+// a long game sends every move in the position command
+static const int maxLineLength = 16384;
+
+static Board board;
+static Search search;
+
+// finds the legal move with this UCI string, noMove if there is none
+static Move parseMove(const char* moveString)
+{
+    MoveList moveList;
+    board.generateLegalMoves(moveList);
+
+    for (Move move : moveList)
+    {
+        char candidate[6];
+        getMoveString(move, candidate);
+        if (!strcmp(candidate, moveString))
+            return move;
+    }
+    return noMove;
+}
+
+// position [startpos | fen <fields>] [moves <move> ...]
+static void setPosition(char* arguments)
+{
+    char* movesToken = strstr(arguments, "moves");
+    if (movesToken)
+        *movesToken = '\0';
+
+    char* fen = strstr(arguments, "fen");
+    board.resetBoard();
+    if (!parseFEN(&board, fen ? fen + 3 + strspn(fen + 3, " ") : startFen))
+    {
+        printf("info string invalid FEN, using the start position\n");
+        board.resetBoard();
+        parseFEN(&board, startFen);
+    }
+
+    if (!movesToken)
+        return;
+
+    for (char* token = strtok(movesToken + 5, " \t\r\n"); token; token = strtok(nullptr, " \t\r\n"))
+    {
+        Move move = parseMove(token);
+        if (move == noMove)
+        {
+            printf("info string illegal move %s\n", token);
+            return;
+        }
+        board.makeMove(move);
+    }
+}
+
+static void printScore(int score)
+{
+    if (score > mateScore - maxPly)
+        printf("score mate %d", (mateScore - score + 1) / 2);
+    else if (score < -mateScore + maxPly)
+        printf("score mate -%d", (mateScore + score) / 2);
+    else
+        printf("score cp %d", score);
+}
+
+static void printIteration(const SearchIteration& iteration)
+{
+    printf("info depth %d ", iteration.depth);
+    printScore(iteration.score);
+    printf(" nodes %llu time %lld nps %llu pv", iteration.nodes, iteration.milliseconds,
+        iteration.nodes * 1000 / (iteration.milliseconds + 1));
+    for (int i = 0; i < iteration.pvLength; ++i)
+    {
+        char moveString[6];
+        getMoveString(iteration.pv[i], moveString);
+        printf(" %s", moveString);
+    }
+    printf("\n");
+    printf("info string ebf %.2f aspiration researches %d qnodes %.1f%% first move cutoffs %.1f%%\n", iteration.branchingFactor,
+        iteration.aspirationResearches, iteration.nodes ? 100.0 * iteration.qnodes / iteration.nodes : 0.0,
+        iteration.cutoffs ? 100.0 * iteration.firstMoveCutoffs / iteration.cutoffs : 0.0);
+    fflush(stdout);
+}
+
+// the search runs on its own thread so stop, ponderhit and isready are read while it thinks
+static std::thread searchThread;
+static std::atomic<bool> stopSignal(false);
+static std::atomic<bool> ponderSignal(false);
+
+static void runSearch(SearchLimits limits, bool isInfinite)
+{
+    search.think(board, limits, printIteration);
+
+    // an infinite or ponder search that ran out of depth still holds its bestmove until stop or ponderhit
+    while ((isInfinite || ponderSignal) && !stopSignal)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    char moveString[6] = "0000";
+    if (search.getBestMove() != noMove)
+        getMoveString(search.getBestMove(), moveString);
+    printf("bestmove %s\n", moveString);
+    fflush(stdout);
+}
+
+// blocks until a running search printed its bestmove
+static void waitForSearch()
+{
+    if (searchThread.joinable())
+        searchThread.join();
+}
+
+static void stopSearch()
+{
+    ponderSignal = false;
+    stopSignal = true;
+    waitForSearch();
+}
+
+// go [depth <plies>] [movetime <ms>] [nodes <count>] [wtime <ms>] [btime <ms>] [winc <ms>] [binc <ms>]
+//    [infinite] [ponder]
+// infinite searches until stop; ponder searches the opponent's time without a time limit until ponderhit
+// switches the clock limits on, the pondering time counting towards them; other keys are skipped one
+// token at a time
+static void go(char* arguments)
+{
+    SearchLimits limits;
+    limits.depth = defaultSearchDepth;
+    limits.stopSignal = &stopSignal;
+    long long times[2] = { 0, 0 };
+    long long increments[2] = { 0, 0 };
+    bool hasDepth = false;
+    bool isTimed = false;
+    bool isInfinite = false;
+    bool isPonder = false;
+
+    for (char* token = strtok(arguments, " \t\r\n"); token; token = strtok(nullptr, " \t\r\n"))
+    {
+        // flags stand alone, the other keys take the next token as their value
+        if (!strcmp(token, "infinite") || !strcmp(token, "ponder"))
+        {
+            isInfinite = isInfinite || !strcmp(token, "infinite");
+            isPonder = isPonder || !strcmp(token, "ponder");
+            continue;
+        }
+
+        long long* clockValue = nullptr;
+        if (!strcmp(token, "wtime"))
+            clockValue = &times[Board::white];
+        else if (!strcmp(token, "btime"))
+            clockValue = &times[Board::black];
+        else if (!strcmp(token, "winc"))
+            clockValue = &increments[Board::white];
+        else if (!strcmp(token, "binc"))
+            clockValue = &increments[Board::black];
+        else if (strcmp(token, "depth") && strcmp(token, "movetime") && strcmp(token, "nodes"))
+            continue;
+
+        char* value = strtok(nullptr, " \t\r\n");
+        if (!value)
+            break;
+
+        if (clockValue)
+        {
+            *clockValue = atoll(value);
+            isTimed = isTimed || clockValue == &times[Board::white] || clockValue == &times[Board::black];
+        }
+        else if (!strcmp(token, "depth"))
+        {
+            if (atoi(value) > 0)
+            {
+                limits.depth = atoi(value) < maxPly ? atoi(value) : maxPly - 1;
+                hasDepth = true;
+            }
+        }
+        else if (!strcmp(token, "movetime"))
+        {
+            limits.moveTime = atoll(value);
+            isTimed = true;
+        }
+        else
+        {
+            limits.nodes = strtoull(value, nullptr, 10);
+            isTimed = true;
+        }
+    }
+
+    // a thirtieth of the clock plus half the increment, at least a few milliseconds
+    int side = board.getSide();
+    if (!limits.moveTime && times[side])
+    {
+        limits.moveTime = times[side] / 30 + increments[side] / 2;
+        if (limits.moveTime < 5)
+            limits.moveTime = 5;
+    }
+
+    // a time or node limit searches as deep as it allows unless a depth is given too,
+    // infinite drops every limit and waits for stop
+    if ((isTimed || isPonder) && !hasDepth)
+        limits.depth = maxPly - 1;
+    if (isPonder)
+        limits.ponderSignal = &ponderSignal;
+    if (isInfinite)
+    {
+        limits.depth = maxPly - 1;
+        limits.moveTime = 0;
+        limits.nodes = 0;
+    }
+
+    waitForSearch();
+    stopSignal = false;
+    ponderSignal = isPonder;
+    searchThread = std::thread(runSearch, limits, isInfinite);
+}
+
+static void printBoard()
+{
+    static const char pieceChars[] = "PpNnBbRrQqKk";
+
+    for (int rank = 0; rank < 8; ++rank)
+    {
+        printf(" %d ", 8 - rank);
+        for (int file = 0; file < 8; ++file)
+        {
+            int piece = board.getPieceOn(rank * 8 + file);
+            printf(" %c", piece == Board::noPiece ? '.' : pieceChars[piece]);
+        }
+        printf("\n");
+    }
+    printf("\n    a b c d e f g h\n\n");
+
+    char fen[96];
+    getFEN(board, fen);
+    printf("fen %s\nkey %016llx\n", fen, board.getKey());
+}
+
+// returns false on quit
+static bool executeCommand(char* line)
+{
+    // drop the line break and trailing blanks so the last argument doesn't carry them
+    size_t length = strlen(line);
+    while (length > 0 && strchr(" \t\r\n", line[length - 1]))
+        line[--length] = '\0';
+
+    // split the command word off the rest of the line
+    char* command = line + strspn(line, " \t\r\n");
+    char* arguments = command + strcspn(command, " \t\r\n");
+    if (*arguments)
+        *arguments++ = '\0';
+    if (!*command)
+        return true;
+
+    // stop, ponderhit and isready are answered while a search runs, the rest wait for it to finish
+    if (!strcmp(command, "stop"))
+        stopSearch();
+    else if (!strcmp(command, "ponderhit"))
+        ponderSignal = false;
+    else if (!strcmp(command, "isready"))
+        printf("readyok\n");
+    else if (!strcmp(command, "quit"))
+    {
+        stopSearch();
+        return false;
+    }
+    else
+    {
+        waitForSearch();
+
+        if (!strcmp(command, "uci"))
+        {
+            printf("id name Chess\n");
+            printf("uciok\n");
+        }
+        else if (!strcmp(command, "ucinewgame"))
+        {
+            search.clear();
+            board.resetBoard();
+            parseFEN(&board, startFen);
+        }
+        else if (!strcmp(command, "position"))
+            setPosition(arguments);
+        else if (!strcmp(command, "go"))
+            go(arguments);
+        else if (!strcmp(command, "d"))
+            printBoard();
+        else if (!strcmp(command, "bench"))
+        {
+            char* depthToken = strtok(arguments, " \t\r\n");
+            runBench(depthToken && atoi(depthToken) > 0 ? atoi(depthToken) : defaultBenchDepth);
+        }
+        else
+            printf("unknown command: %s\n", command);
+    }
+
+    fflush(stdout);
+    return true;
+}
+
+int runUci(int argc, char** argv)
+{
+    board.resetBoard();
+    parseFEN(&board, startFen);
+
+    static char line[maxLineLength];
+
+    // commands on the command line run once, for scripts and quick benches
+    if (argc > 1)
+    {
+        line[0] = '\0';
+        for (int i = 1; i < argc; ++i)
+        {
+            strncat(line, argv[i], sizeof(line) - strlen(line) - 2);
+            strcat(line, " ");
+        }
+        if (executeCommand(line))
+            waitForSearch();
+        return 0;
+    }
+
+    while (fgets(line, sizeof(line), stdin))
+    {
+        if (!executeCommand(line))
+            return 0;
+    }
+
+    // nothing can send stop once the input ended, an infinite or ponder search would never return
+    stopSearch();
+    return 0;
+}
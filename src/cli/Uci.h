@@ -0,0 +1,6 @@
+#pragma once
+
+// UCI front end of the headless engine: reads commands from stdin until quit, or, with commands on
+// the command line like "bench 6", runs those once and returns; go searches on a second thread until
+// stop or quit arrive or its limits are reached, ponderhit puts a ponder search on the clock
+int runUci(int argc, char** argv);
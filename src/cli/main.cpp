@@ -0,0 +1,7 @@
+#include "Uci.h"
+
+// headless engine, speaks UCI on stdin/stdout and links nothing but the engine core
+int main(int argc, char** argv)
+{
+    return runUci(argc, argv);
+}
@@ -0,0 +1,270 @@
+#include "AttackTables.h"
+
+// the tables below are evaluated by the compiler, only the slider backend choice runs at startup
+
+constexpr U64 notAfile = 0xFEFEFEFEFEFEFEFE;
+constexpr U64 notHfile = 0x7F7F7F7F7F7F7F7F;
+constexpr U64 notABfile = 0xFCFCFCFCFCFCFCFC;
+constexpr U64 notGHfile = 0x3F3F3F3F3F3F3F3F;
+
+static constexpr U64 generatePawnAttacks(int side, int square)
+{
+    U64 attackBitboard = 0ULL;
+    U64 bitboard = 1ULL << square;
+
+    // white
+    if (!side)
+    {
+        // if the white pawn is not on A file, up left is possible
+        if (bitboard & notAfile)
+            attackBitboard |= (bitboard >> 9);
+        // if the white pawn is not on H file, up right is possible
+        if (bitboard & notHfile)
+            attackBitboard |= (bitboard >> 7);
+    }
+    // black
+    else
+    {
+        // if the black pawn is not on A file, down left is possible
+        if (bitboard & notAfile)
+            attackBitboard |= (bitboard << 7);
+        // if the black pawn is not on H file, down right is possible
+        if (bitboard & notHfile)
+            attackBitboard |= (bitboard << 9);
+    }
+
+    return attackBitboard;
+}
+
+static constexpr U64 generateKnightAttacks(int square)
+{
+    U64 attackBitboard = 0ULL;
+    U64 bitboard = 1ULL << square;
+
+    // if the knight is not on A file, up up left and down down left is possible
+    if (bitboard & notAfile)
+    {
+        attackBitboard |= (bitboard >> 17);
+        attackBitboard |= (bitboard << 15);
+    }
+    // if the knight is not on A or B file, up left left and down left left is possible
+    if (bitboard & notABfile)
+    {
+        attackBitboard |= (bitboard >> 10);
+        attackBitboard |= (bitboard << 6);
+    }
+    // if the knight is not on G or H file, up right right and down right right is possible
+    if (bitboard & notGHfile)
+    {
+        attackBitboard |= (bitboard >> 6);
+        attackBitboard |= (bitboard << 10);
+    }
+    // if the knight is not on H file, up up right and down down right is possible
+    if (bitboard & notHfile)
+    {
+        attackBitboard |= (bitboard >> 15);
+        attackBitboard |= (bitboard << 17);
+    }
+
+    return attackBitboard;
+}
+
+static constexpr U64 generateKingAttacks(int square)
+{
+    U64 attackBitboard = 0ULL;
+    U64 bitboard = 1ULL << square;
+
+    // if the king is not on A file, up left and left and down left is possible
+    if (bitboard & notAfile)
+    {
+        attackBitboard |= (bitboard >> 9);
+        attackBitboard |= (bitboard >> 1);
+        attackBitboard |= (bitboard << 7);
+    }
+    // if the king is not on H file, up right and right and down right is possible
+    if (bitboard & notHfile)
+    {
+        attackBitboard |= (bitboard >> 7);
+        attackBitboard |= (bitboard << 1);
+        attackBitboard |= (bitboard << 9);
+    }
+    // up and down is possible
+    attackBitboard |= (bitboard >> 8);
+    attackBitboard |= (bitboard << 8);
+
+    return attackBitboard;
+}
+
+// walks the four rays given by the rank/file steps, either up to the board edge or,
+// for relevant occupancy masks, up to but not including the edge squares
+static constexpr U64 generateSliderAttacks(const int (&rankSteps)[4], const int (&fileSteps)[4], int square, U64 occ, bool isMask)
+{
+    U64 attackBitboard = 0ULL;
+    int targetRank = square / 8;
+    int targetFile = square % 8;
+
+    for (int direction = 0; direction < 4; ++direction)
+    {
+        int rankStep = rankSteps[direction];
+        int fileStep = fileSteps[direction];
+
+        for (int rank = targetRank + rankStep, file = targetFile + fileStep; rank >= 0 && rank <= 7 && file >= 0 && file <= 7; rank += rankStep, file += fileStep)
+        {
+            // the last square on a ray never blocks anything, so it is not part of the mask
+            if (isMask && (rank + rankStep < 0 || rank + rankStep > 7 || file + fileStep < 0 || file + fileStep > 7))
+                break;
+
+            attackBitboard |= (1ULL << (rank * 8 + file));
+            // a piece is in the way, stop looking
+            if ((1ULL << (rank * 8 + file)) & occ)
+                break;
+        }
+    }
+
+    return attackBitboard;
+}
+
+constexpr int bishopRankSteps[4] = { -1, -1, 1, 1 };
+constexpr int bishopFileSteps[4] = { -1, 1, -1, 1 };
+constexpr int rookRankSteps[4] = { -1, 1, 0, 0 };
+constexpr int rookFileSteps[4] = { 0, 0, -1, 1 };
+
+static constexpr U64 generateBishopAttacks(int square, U64 occ) { return generateSliderAttacks(bishopRankSteps, bishopFileSteps, square, occ, false); }
+static constexpr U64 generateBishopMask(int square) { return generateSliderAttacks(bishopRankSteps, bishopFileSteps, square, 0ULL, true); }
+static constexpr U64 generateRookAttacks(int square, U64 occ) { return generateSliderAttacks(rookRankSteps, rookFileSteps, square, occ, false); }
+static constexpr U64 generateRookMask(int square) { return generateSliderAttacks(rookRankSteps, rookFileSteps, square, 0ULL, true); }
+
+static constexpr std::array<std::array<U64, 64>, 2> generatePawnAttackTable()
+{
+    std::array<std::array<U64, 64>, 2> table = {};
+    for (int square = 0; square < 64; ++square)
+    {
+        table[0][square] = generatePawnAttacks(0, square);
+        table[1][square] = generatePawnAttacks(1, square);
+    }
+    return table;
+}
+
+static constexpr std::array<U64, 64> generateSquareTable(U64 (*generator)(int))
+{
+    std::array<U64, 64> table = {};
+    for (int square = 0; square < 64; ++square)
+        table[square] = generator(square);
+    return table;
+}
+
+static constexpr int countMaskBits(U64 maskBitboard)
+{
+    int count = 0;
+    for (; maskBitboard; maskBitboard &= maskBitboard - 1)
+        ++count;
+    return count;
+}
+
+static constexpr std::array<SliderLookup, 64> generateSliderLookups(bool isBishop)
+{
+    std::array<SliderLookup, 64> lookups = {};
+    unsigned int offset = isBishop ? 0 : getSliderTableSize(bishopRelevantBitCount);
+    unsigned int pextOffset = isBishop ? 0 : 5248;
+    for (int square = 0; square < 64; ++square)
+    {
+        int bitCount = isBishop ? bishopRelevantBitCount[square] : rookRelevantBitCount[square];
+        U64 maskBitboard = isBishop ? generateBishopMask(square) : generateRookMask(square);
+
+        lookups[square].mask = maskBitboard;
+        lookups[square].magic = isBishop ? bishopMagicNumbers[square] : rookMagicNumbers[square];
+        lookups[square].shift = 64 - bitCount;
+        lookups[square].offset = offset;
+        lookups[square].pextOffset = pextOffset;
+        offset += 1u << bitCount;
+        pextOffset += 1u << countMaskBits(maskBitboard);
+    }
+    return lookups;
+}
+
+constexpr std::array<SliderLookup, 64> bishopLookups = generateSliderLookups(true);
+constexpr std::array<SliderLookup, 64> rookLookups = generateSliderLookups(false);
+
+static_assert(rookLookups[63].offset + (1u << rookRelevantBitCount[63]) == sliderAttackTableSize, "sliderAttackTableSize doesn't match the relevant bit counts");
+static_assert(rookLookups[63].pextOffset + (1u << countMaskBits(rookLookups[63].mask)) == sliderPextAttackTableSize, "sliderPextAttackTableSize doesn't match the masks");
+
+// for every pair of squares on a common rank, file or diagonal, either the squares strictly
+// between them or the whole edge to edge line through both; zero for unaligned pairs
+static constexpr std::array<std::array<U64, 64>, 64> generateRayTable(bool isLine)
+{
+    constexpr int rankSteps[8] = { -1, -1, 1, 1, -1, 1, 0, 0 };
+    constexpr int fileSteps[8] = { -1, 1, -1, 1, 0, 0, -1, 1 };
+
+    std::array<std::array<U64, 64>, 64> table = {};
+    for (int square = 0; square < 64; ++square)
+    {
+        for (int direction = 0; direction < 8; ++direction)
+        {
+            int rankStep = rankSteps[direction];
+            int fileStep = fileSteps[direction];
+            // the line runs through the square in this direction and the opposite one
+            U64 line = 1ULL << square;
+            for (int sign = -1; sign <= 1; sign += 2)
+            {
+                for (int rank = square / 8 + sign * rankStep, file = square % 8 + sign * fileStep; rank >= 0 && rank <= 7 && file >= 0 && file <= 7; rank += sign * rankStep, file += sign * fileStep)
+                    line |= 1ULL << (rank * 8 + file);
+            }
+
+            U64 between = 0ULL;
+            for (int rank = square / 8 + rankStep, file = square % 8 + fileStep; rank >= 0 && rank <= 7 && file >= 0 && file <= 7; rank += rankStep, file += fileStep)
+            {
+                table[square][rank * 8 + file] = isLine ? line : between;
+                between |= 1ULL << (rank * 8 + file);
+            }
+        }
+    }
+    return table;
+}
+
+template <int TableSize>
+static constexpr std::array<U64, TableSize> generateSliderAttackTable(bool isPext)
+{
+    std::array<U64, TableSize> table = {};
+    for (int piece = 0; piece < 2; ++piece)
+    {
+        bool isBishop = piece == 0;
+
+        for (int square = 0; square < 64; ++square)
+        {
+            const SliderLookup& lookup = isBishop ? bishopLookups[square] : rookLookups[square];
+
+            // visit every subset of the mask (Carry-Rippler), which also happens to be the order pext numbers them
+            U64 occ = 0ULL;
+            unsigned int pextIndex = 0;
+            do
+            {
+                unsigned int index = isPext ? lookup.pextOffset + pextIndex++ : lookup.offset + (unsigned int)((occ * lookup.magic) >> lookup.shift);
+                table[index] = isBishop ? generateBishopAttacks(square, occ) : generateRookAttacks(square, occ);
+
+                occ = (occ - lookup.mask) & lookup.mask;
+            } while (occ);
+        }
+    }
+    return table;
+}
+
+constexpr std::array<std::array<U64, 64>, 2> pawnAttackTable = generatePawnAttackTable();
+constexpr std::array<U64, 64> knightAttackTable = generateSquareTable(generateKnightAttacks);
+constexpr std::array<U64, 64> bishopAttackMask = generateSquareTable(generateBishopMask);
+constexpr std::array<U64, 64> rookAttackMask = generateSquareTable(generateRookMask);
+constexpr std::array<U64, 64> kingAttackTable = generateSquareTable(generateKingAttacks);
+constexpr std::array<std::array<U64, 64>, 64> betweenTable = generateRayTable(false);
+constexpr std::array<std::array<U64, 64>, 64> lineTable = generateRayTable(true);
+constexpr std::array<U64, sliderAttackTableSize> sliderAttackTable = generateSliderAttackTable<sliderAttackTableSize>(false);
+constexpr std::array<U64, sliderPextAttackTableSize> sliderPextAttackTable = generateSliderAttackTable<sliderPextAttackTableSize>(true);
+
+SliderBackend sliderBackend = cpuHasFastPext() ? pextBackend : magicBackend;
+
+bool setSliderBackend(SliderBackend backend)
+{
+    if (backend == pextBackend && !cpuHasPext())
+        return false;
+
+    sliderBackend = backend;
+    return true;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+
+#include "BitOps.h"
+#include "CpuFeatures.h"
+#include "MagicNumbers.h"
+
+// slider lookup backends, the fastest supported one is picked at startup
+enum SliderBackend
+{
+    magicBackend,
+    pextBackend
+};
+
+// everything a slider lookup needs for one square, so a lookup touches a single cache line
+struct alignas(32) SliderLookup
+{
+    U64 mask;
+    U64 magic;
+    unsigned int shift;
+    // first entry of the square in the packed magic and pext attack tables
+    unsigned int offset;
+    unsigned int pextOffset;
+};
+
+constexpr int getSliderTableSize(const int (&bitCounts)[64])
+{
+    int size = 0;
+    for (int square = 0; square < 64; ++square)
+        size += 1 << bitCounts[square];
+    return size;
+}
+
+// every square owns 2^relevantBitCount consecutive entries, bishops first then rooks;
+// pext can't share entries and always needs 2^popcount(mask), 5248 for bishops and 102400 for rooks
+constexpr int sliderAttackTableSize = getSliderTableSize(bishopRelevantBitCount) + getSliderTableSize(rookRelevantBitCount);
+constexpr int sliderPextAttackTableSize = 5248 + 102400;
+
+// precomputed attack tables, generated at compile time into read-only data shared by every Board
+extern const std::array<std::array<U64, 64>, 2> pawnAttackTable;
+extern const std::array<U64, 64> knightAttackTable;
+extern const std::array<U64, 64> bishopAttackMask;
+extern const std::array<U64, 64> rookAttackMask;
+extern const std::array<U64, 64> kingAttackTable;
+// squares strictly between two aligned squares, and the full line through them; 0 if not aligned
+extern const std::array<std::array<U64, 64>, 64> betweenTable;
+extern const std::array<std::array<U64, 64>, 64> lineTable;
+
+extern const std::array<SliderLookup, 64> bishopLookups;
+extern const std::array<SliderLookup, 64> rookLookups;
+extern const std::array<U64, sliderAttackTableSize> sliderAttackTable;
+// the same attacks indexed by pext(occupancy, mask) instead of a magic multiply
+extern const std::array<U64, sliderPextAttackTableSize> sliderPextAttackTable;
+
+extern SliderBackend sliderBackend;
+// returns false and keeps the current backend if the CPU can't run the requested one
+bool setSliderBackend(SliderBackend backend);
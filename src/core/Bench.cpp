@@ -0,0 +1,135 @@
+#include "Bench.h"
+#include "Fen.h"
+#include "Search.h"
+
+#include <chrono>
+#include <string.h>
+
+// openings, middlegames, endgames, and a few positions that are mate, stalemate or close to it
+static const char* benchFens[] = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 10",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 11",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+    "rnbqkbnr/pp1ppppp/8/2p5/4P3/8/PPPP1PPP/RNBQKBNR w KQkq c6 0 2",
+    "rnbqkb1r/pp2pppp/3p1n2/8/3NP3/8/PPP2PPP/RNBQKB1R w KQkq - 1 5",
+    "r1bqkbnr/pppp1ppp/2n5/1B2p3/4P3/5N2/PPPP1PPP/RNBQK2R b KQkq - 3 3",
+    "r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4",
+    "rnbqkb1r/pppppp1p/5np1/8/2PP4/2N5/PP2PPPP/R1BQKBNR b KQkq - 1 3",
+    "rnbqk2r/ppp1ppbp/3p1np1/8/2PPP3/2N5/PP3PPP/R1BQKBNR w KQkq - 0 5",
+    "rnbqkbnr/ppp2ppp/4p3/3p4/3PP3/8/PPP2PPP/RNBQKBNR w KQkq d6 0 3",
+    "rnbqkb1r/ppp1pppp/5n2/3p4/3P4/2N5/PPP1PPPP/R1BQKBNR w KQkq - 2 3",
+    "4rrk1/pp1n3p/3q2pQ/2p1pb2/2PP4/2P3N1/P2B2PP/4RRK1 b - - 7 19",
+    "rq3rk1/ppp2ppp/1bnpb3/3N2B1/3NP3/7P/PPPQ1PP1/2KR3R w - - 7 14",
+    "r1bq1r1k/1pp1n1pp/1p1p4/4p2Q/4Pp2/1BNP4/PPP2PPP/3R1RK1 w - - 2 14",
+    "r3r1k1/2p2ppp/p1p1bn2/8/1q2P3/2NPQN2/PPP3PP/R4RK1 b - - 2 15",
+    "r1bbk1nr/pp3p1p/2n5/1N4p1/2Np1B2/8/PPP2PPP/2KR1B1R w kq - 0 13",
+    "r1bq1rk1/ppp1nppp/4n3/3p3Q/3P4/1BP1B3/PP1N2PP/R4RK1 w - - 1 16",
+    "4r1k1/r1q2ppp/ppp2n2/4P3/5Rb1/1N1BQ3/PPP3PP/R5K1 w - - 1 17",
+    "2rqkb1r/ppp2p2/2npb1p1/1N1Nn2p/2P1PP2/8/PP2B1PP/R1BQK2R b KQ - 0 11",
+    "r1bq1r1k/b1p1npp1/p2p3p/1p6/3PP3/1B2NN2/PP3PPP/R2Q1RK1 w - - 1 16",
+    "3r1rk1/p5pp/bpp1pp2/8/q1PP1P2/b3P3/P2NQRPP/1R2B1K1 b - - 6 22",
+    "r1q2rk1/2p1bppp/2Pp4/p6b/Q1PNp3/4B3/PP1R1PPP/2K4R w - - 2 18",
+    "4k2r/1pb2ppp/1p2p3/1R1p4/3P4/2r1PN2/P4PPP/1R4K1 b - - 3 22",
+    "3q2k1/pb3p1p/4pbp1/2r5/PpN2N2/1P2P2P/5PP1/Q2R2K1 b - - 4 26",
+    "r2q1rk1/1b1nbppp/pp1ppn2/8/2PQP3/1PN2NP1/PB3PBP/R4RK1 w - - 0 11",
+    "r4rk1/pp3ppp/2n1b3/q1pp4/3P4/P1PBPN2/2Q2PPP/R4RK1 w - - 0 14",
+    "6k1/3b3r/1p1p4/p1n2p2/1PPNpP1q/P3Q1p1/1R1RB1P1/5K2 b - - 0 1",
+    "r2r1n2/pp2bk2/2p1p2p/3q4/3PN1QP/2P3R1/P4PP1/5RK1 w - - 0 1",
+    "2r5/8/1n6/1P1p1pkp/p2P4/R1P1PKP1/8/1R6 w - - 0 1",
+    "6k1/6p1/6Pp/ppp5/3pn2P/1P3K2/1PP2P2/8 b - - 0 1",
+    "8/8/8/8/5kp1/P7/8/1K1N4 w - - 0 1",
+    "8/8/8/5N2/8/p7/8/2NK3k w - - 0 1",
+    "8/3k4/8/8/8/4B3/4KB2/2B5 w - - 0 1",
+    "8/8/1P6/5pr1/8/4R3/7k/2K5 w - - 0 1",
+    "8/2p4P/8/kr6/6R1/8/8/1K6 w - - 0 1",
+    "8/8/3P3k/8/1p6/8/1P6/1K3n2 b - - 0 1",
+    "8/R7/2q5/8/6k1/8/1P5p/K6R w - - 0 124",
+    "6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1",
+    "8/p7/1p6/2p5/2P5/1P6/P7/k1K5 w - - 0 1",
+    "8/8/4k3/8/2p5/2P5/4K3/8 w - - 0 1",
+    "4k3/8/8/8/8/8/4P3/4K3 w - - 0 1",
+    "8/5k2/8/8/8/8/1R6/4K3 w - - 0 1",
+    "8/8/8/4k3/8/8/3QK3/8 w - - 0 1",
+    "8/8/8/8/8/6k1/6p1/6K1 w - - 0 1",
+    "7k/7P/6K1/8/3B4/8/8/8 b - - 0 1",
+    "6k1/5ppp/8/8/8/8/5PPP/1r4K1 w - - 0 1",
+    "7k/5Q2/6K1/8/8/8/8/8 b - - 0 1",
+};
+
+// per depth totals over all positions: iterations finished, time to reach the depth and nodes of the iteration
+static int depthCounts[maxPly];
+static long long depthMilliseconds[maxPly];
+static U64 depthNodes[maxPly];
+
+static void recordIteration(const SearchIteration& iteration)
+{
+    depthCounts[iteration.depth]++;
+    depthMilliseconds[iteration.depth] += iteration.milliseconds;
+    depthNodes[iteration.depth] += iteration.iterationNodes;
+}
+
+U64 runBench(int depth)
+{
+    static Board board;
+    static Search search;
+
+    const int positionCount = sizeof(benchFens) / sizeof(benchFens[0]);
+    U64 totalNodes = 0;
+    U64 totalQnodes = 0;
+    U64 totalCutoffs = 0;
+    U64 totalFirstMoveCutoffs = 0;
+
+    memset(depthCounts, 0, sizeof(depthCounts));
+    memset(depthMilliseconds, 0, sizeof(depthMilliseconds));
+    memset(depthNodes, 0, sizeof(depthNodes));
+
+    SearchLimits limits;
+    limits.depth = depth;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < positionCount; ++i)
+    {
+        board.resetBoard();
+        if (!parseFEN(&board, benchFens[i]))
+        {
+            printf("invalid FEN: %s\n", benchFens[i]);
+            continue;
+        }
+
+        search.clear();
+        int score = search.think(board, limits, recordIteration);
+
+        char moveString[6] = "none";
+        if (search.getBestMove() != noMove)
+            getMoveString(search.getBestMove(), moveString);
+
+        printf("position %2d/%d  %-5s %6d  %10llu nodes\n", i + 1, positionCount, moveString, score, search.getStats().nodes);
+        totalNodes += search.getStats().nodes;
+        totalQnodes += search.getStats().qnodes;
+        totalCutoffs += search.getStats().cutoffs;
+        totalFirstMoveCutoffs += search.getStats().firstMoveCutoffs;
+    }
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    // the branching factor of a depth compares its iterations to the ones a ply shallower
+    printf("\ndepth  positions  avg ms to depth  avg iteration nodes    ebf\n");
+    for (int d = 1; d <= depth && d < maxPly && depthCounts[d]; ++d)
+    {
+        double branchingFactor = d > 1 && depthNodes[d - 1] ? (double)depthNodes[d] / depthNodes[d - 1] : 0.0;
+        printf("%5d  %9d  %15.1f  %19.0f  %5.2f\n", d, depthCounts[d], (double)depthMilliseconds[d] / depthCounts[d],
+            (double)depthNodes[d] / depthCounts[d], branchingFactor);
+    }
+
+    printf("\n===========================\n");
+    printf("Total time (ms) : %.0f\n", seconds * 1000.0);
+    printf("Nodes searched  : %llu\n", totalNodes);
+    printf("Quiescence nodes: %llu (%.1f%%)\n", totalQnodes, totalNodes ? 100.0 * totalQnodes / totalNodes : 0.0);
+    printf("First move cuts : %.1f%% of %llu cutoffs\n", totalCutoffs ? 100.0 * totalFirstMoveCutoffs / totalCutoffs : 0.0, totalCutoffs);
+    printf("Nodes/second    : %.0f\n", totalNodes / seconds);
+
+    return totalNodes;
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "Board.h"
+
+constexpr int defaultBenchDepth = 6;
+
+// searches a fixed list of positions to a fixed depth, one after another on a single thread with
+// fresh search tables for each, and prints the total node count and speed; the node count is a
+// signature of the search, anything that changes the tree changes it while pure speedups keep it
+U64 runBench(int depth);
@@ -0,0 +1,107 @@
+#pragma once
+
+typedef unsigned long long U64;
+
+// hardware bit operations on bitboards, GCC/Clang builtins or MSVC intrinsics with a portable
+// fallback; lsb/msb/popLSB expect a non-empty bitboard
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+#if defined(__BMI2__) || (defined(_MSC_VER) && defined(__AVX2__))
+#include <immintrin.h>
+#define BITOPS_HARDWARE_PEXT 1
+#endif
+
+inline int countBits(U64 bb)
+{
+#if defined(__GNUC__)
+    return __builtin_popcountll(bb);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return (int)__popcnt64(bb);
+#else
+    // SWAR popcount
+    bb = bb - ((bb >> 1) & 0x5555555555555555ULL);
+    bb = (bb & 0x3333333333333333ULL) + ((bb >> 2) & 0x3333333333333333ULL);
+    bb = (bb + (bb >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((bb * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+inline int getLSB(U64 bb)
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll(bb);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, bb);
+    return (int)index;
+#else
+    // de Bruijn multiplication on the isolated lowest bit
+    static const int index64[64] = {
+        0, 1, 48, 2, 57, 49, 28, 3, 61, 58, 50, 42, 38, 29, 17, 4,
+        62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12, 5,
+        63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+        46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19, 9, 13, 8, 7, 6
+    };
+    return index64[((bb & (0ULL - bb)) * 0x03F79D71B4CB0A89ULL) >> 58];
+#endif
+}
+
+inline int getMSB(U64 bb)
+{
+#if defined(__GNUC__)
+    return 63 ^ __builtin_clzll(bb);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanReverse64(&index, bb);
+    return (int)index;
+#else
+    int index = 0;
+    while (bb >>= 1)
+        index++;
+    return index;
+#endif
+}
+
+// returns the lowest set square and clears it, compiles to tzcnt + blsr with BMI
+inline int popLSB(U64& bb)
+{
+    int square = getLSB(bb);
+    bb &= bb - 1;
+    return square;
+}
+
+// gathers the bits of src selected by mask into the low bits
+inline U64 pext(U64 src, U64 mask)
+{
+#if defined(BITOPS_HARDWARE_PEXT)
+    return _pext_u64(src, mask);
+#else
+    U64 result = 0ULL;
+    for (U64 bit = 1ULL; mask; bit <<= 1)
+    {
+        if (src & mask & (0ULL - mask))
+            result |= bit;
+        mask &= mask - 1;
+    }
+    return result;
+#endif
+}
+
+// scatters the low bits of src onto the bits set in mask
+inline U64 pdep(U64 src, U64 mask)
+{
+#if defined(BITOPS_HARDWARE_PEXT)
+    return _pdep_u64(src, mask);
+#else
+    U64 result = 0ULL;
+    for (U64 bit = 1ULL; mask; bit <<= 1)
+    {
+        if (src & bit)
+            result |= mask & (0ULL - mask);
+        mask &= mask - 1;
+    }
+    return result;
+#endif
+}
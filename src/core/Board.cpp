@@ -0,0 +1,664 @@
+#include "Board.h"
+
+#if defined(PEXT_BACKEND_AVAILABLE)
+#include <immintrin.h>
+#endif
+
+U64 Board::getPawnAttackBitboard(int side, int square)
+{
+    return pawnAttackTable[side][square];
+}
+
+U64 Board::getKnightAttackBitboard(int square)
+{
+    return knightAttackTable[square];
+}
+
+U64 Board::getBishopMaskBitboard(int square)
+{
+    return bishopAttackMask[square];
+}
+
+U64 Board::getBishopAttackBitboardRuntime(U64 board, int square)
+{
+    U64 attackBitboard = 0ULL;
+
+    int rank, file;
+    int targetRank = square / 8;
+    int targetFile = square % 8;
+
+    // up left diagonal
+    for (rank = targetRank - 1, file = targetFile - 1; rank >= 0 && file >= 0; --rank, --file)
+    {
+        attackBitboard |= (1ULL << (rank * 8 + file));
+        // a piece is in the way, stop looking
+        if ((1ULL << (rank * 8 + file)) & board)
+            break;
+    }
+    // up right diagonal
+    for (rank = targetRank - 1, file = targetFile + 1; rank >= 0 && file <= 7; --rank, ++file)
+    {
+        attackBitboard |= (1ULL << (rank * 8 + file));
+        // a piece is in the way, stop looking
+        if ((1ULL << (rank * 8 + file)) & board)
+            break;
+    }
+    // down left diagonal
+    for (rank = targetRank + 1, file = targetFile - 1; rank <= 7 && file >= 0; ++rank, --file)
+    {
+        attackBitboard |= (1ULL << (rank * 8 + file));
+        // a piece is in the way, stop looking
+        if ((1ULL << (rank * 8 + file)) & board)
+            break;
+    }
+    // down right diagonal
+    for (rank = targetRank + 1, file = targetFile + 1; rank <= 7 && file <= 7; ++rank, ++file)
+    {
+        attackBitboard |= (1ULL << (rank * 8 + file));
+        // a piece is in the way, stop looking
+        if ((1ULL << (rank * 8 + file)) & board)
+            break;
+    }
+
+    return attackBitboard;
+}
+
+U64 Board::getBishopAttackBitboard(U64 occ, int square)
+{
+    if (sliderBackend == pextBackend)
+        return getBishopAttackBitboardPext(occ, square);
+
+    return getBishopAttackBitboardMagic(occ, square);
+}
+
+U64 Board::getBishopAttackBitboardMagic(U64 occ, int square)
+{
+    const SliderLookup& lookup = bishopLookups[square];
+
+    occ &= lookup.mask;
+    occ *= lookup.magic;
+    occ >>= lookup.shift;
+
+    return sliderAttackTable[lookup.offset + occ];
+}
+
+U64 Board::getRookMaskBitboard(int square)
+{
+    return rookAttackMask[square];
+}
+
+U64 Board::getRookAttackBitboardRuntime(U64 board, int square)
+{
+    U64 attackBitboard = 0ULL;
+
+    int rank, file;
+    int targetRank = square / 8;
+    int targetFile = square % 8;
+
+    // up
+    for (rank = targetRank - 1; rank >= 0; --rank)
+    {
+        attackBitboard |= (1ULL << (rank * 8 + targetFile));
+        // a piece is in the way, stop looking
+        if ((1ULL << (rank * 8 + targetFile)) & board)
+            break;
+    }
+    // down
+    for (rank = targetRank + 1; rank <= 7; ++rank)
+    {
+        attackBitboard |= (1ULL << (rank * 8 + targetFile));
+        // a piece is in the way, stop looking
+        if ((1ULL << (rank * 8 + targetFile)) & board)
+            break;
+    }
+    // left
+    for (file = targetFile - 1; file >= 0; --file)
+    {
+        attackBitboard |= (1ULL << (targetRank * 8 + file));
+        // a piece is in the way, stop looking
+        if ((1ULL << (targetRank * 8 + file)) & board)
+            break;
+    }
+    // right
+    for (file = targetFile + 1; file <= 7; ++file)
+    {
+        attackBitboard |= (1ULL << (targetRank * 8 + file));
+        // a piece is in the way, stop looking
+        if ((1ULL << (targetRank * 8 + file)) & board)
+            break;
+    }
+
+    return attackBitboard;
+}
+
+U64 Board::getRookAttackBitboard(U64 occ, int square)
+{
+    if (sliderBackend == pextBackend)
+        return getRookAttackBitboardPext(occ, square);
+
+    return getRookAttackBitboardMagic(occ, square);
+}
+
+U64 Board::getRookAttackBitboardMagic(U64 occ, int square)
+{
+    const SliderLookup& lookup = rookLookups[square];
+
+    occ &= lookup.mask;
+    occ *= lookup.magic;
+    occ >>= lookup.shift;
+
+    return sliderAttackTable[lookup.offset + occ];
+}
+
+U64 Board::getQueenAttackBitboard(U64 occ, int square)
+{
+    if (sliderBackend == pextBackend)
+        return getBishopAttackBitboardPext(occ, square) | getRookAttackBitboardPext(occ, square);
+
+    return getBishopAttackBitboardMagic(occ, square) | getRookAttackBitboardMagic(occ, square);
+}
+
+#if defined(PEXT_BACKEND_AVAILABLE)
+PEXT_TARGET U64 Board::getBishopAttackBitboardPext(U64 occ, int square)
+{
+    const SliderLookup& lookup = bishopLookups[square];
+    return sliderPextAttackTable[lookup.pextOffset + _pext_u64(occ, lookup.mask)];
+}
+
+PEXT_TARGET U64 Board::getRookAttackBitboardPext(U64 occ, int square)
+{
+    const SliderLookup& lookup = rookLookups[square];
+    return sliderPextAttackTable[lookup.pextOffset + _pext_u64(occ, lookup.mask)];
+}
+#else
+// never selected without BMI2, kept so callers don't need to know the platform
+U64 Board::getBishopAttackBitboardPext(U64 occ, int square)
+{
+    return getBishopAttackBitboardMagic(occ, square);
+}
+
+U64 Board::getRookAttackBitboardPext(U64 occ, int square)
+{
+    return getRookAttackBitboardMagic(occ, square);
+}
+#endif
+
+U64 Board::getKingAttackBitboard(int square)
+{
+    return kingAttackTable[square];
+}
+
+// move generator methods
+
+U64 Board::getPieceAttackBitboard(int piece, int square, U64 occ)
+{
+    switch (piece >> 1)
+    {
+        case 0:
+            return getPawnAttackBitboard(piece & 1, square);
+        case 1:
+            return getKnightAttackBitboard(square);
+        case 2:
+            return getBishopAttackBitboard(occ, square);
+        case 3:
+            return getRookAttackBitboard(occ, square);
+        case 4:
+            return getQueenAttackBitboard(occ, square);
+        default:
+            return getKingAttackBitboard(square);
+    }
+}
+
+U64 Board::attackersTo(int square, U64 occ) const
+{
+    const U64* pieces = m_pos.pieces;
+    U64 bishopsQueens = pieces[whiteBishop] | pieces[blackBishop] | pieces[whiteQueen] | pieces[blackQueen];
+    U64 rooksQueens = pieces[whiteRook] | pieces[blackRook] | pieces[whiteQueen] | pieces[blackQueen];
+
+    // a white pawn attacks the square if a black pawn standing there would attack it, and vice versa
+    return (getPawnAttackBitboard(black, square) & pieces[whitePawn])
+        | (getPawnAttackBitboard(white, square) & pieces[blackPawn])
+        | (getKnightAttackBitboard(square) & (pieces[whiteKnight] | pieces[blackKnight]))
+        | (getKingAttackBitboard(square) & (pieces[whiteKing] | pieces[blackKing]))
+        | (getBishopAttackBitboard(occ, square) & bishopsQueens)
+        | (getRookAttackBitboard(occ, square) & rooksQueens);
+}
+
+U64 Board::getSideAttacks(int side) const
+{
+    const U64* pieces = m_pos.pieces;
+
+    return getPawnAttacksSetwise(side, pieces[whitePawn + side])
+        | getKnightAttacksSetwise(pieces[whiteKnight + side])
+        | getKingAttacksSetwise(pieces[whiteKing + side])
+        | getSliderAttacksSetwise(pieces[whiteRook + side] | pieces[whiteQueen + side],
+            pieces[whiteBishop + side] | pieces[whiteQueen + side], m_pos.occupied[both]);
+}
+
+bool Board::isSquareAttacked(int side, int square) const
+{
+    if (m_trackAttackMaps)
+        return getBit(m_attackMap[side], square) != 0;
+
+    if (side == white)
+        return getAttackersOf<white>(square, m_pos.occupied[both]) != 0;
+
+    return getAttackersOf<black>(square, m_pos.occupied[both]) != 0;
+}
+
+bool Board::isAnySquareAttacked(int side, U64 squares) const
+{
+    return side == white ? isAnySquareAttacked<white>(squares) : isAnySquareAttacked<black>(squares);
+}
+
+void Board::setAttackMapTracking(bool enabled)
+{
+    m_trackAttackMaps = enabled;
+
+    if (enabled)
+        updateAttackMaps();
+}
+
+void Board::updateAttackMaps()
+{
+    m_attackMap[white] = getSideAttacks(white);
+    m_attackMap[black] = getSideAttacks(black);
+}
+
+U64 Board::setOccupancy(U64 maskBitboard, int index, int maskBitCount)
+{
+    U64 occupancy = 0ULL;
+
+    for (int count = 0; count < maskBitCount; ++count)
+    {
+        int square = popLSB(maskBitboard);
+
+        if (index & (1 << count))
+            occupancy |= (1ULL << square);
+    }
+
+    return occupancy;
+}
+
+void Board::printBitboard(U64 bitboard)
+{
+    printf("\n");
+    
+    for (int i = 0; i < 8; ++i)
+    {
+        for (int j = 0; j < 8; ++j)
+        {
+            int square = i * 8 + j;
+
+            // print ranks
+            if (!j)
+                printf("%d  ", 8 - i);
+
+            printf("%d ", getBit(bitboard, square) ? 1 : 0);
+        }
+        printf("\n");
+    }
+
+    printf("\n   a b c d e f g h\n\n");
+}
+
+void Board::updateOccupiedBitboards()
+{
+    resetOccupiedBitboards();
+
+    for (int i = 0; i < 12; ++i)
+    {
+        // both
+        addOccupiedBitboard(both, m_pos.pieces[i]);
+        // white pieces
+        if (i % 2 == 0)
+        {
+            addOccupiedBitboard(white, m_pos.pieces[i]);
+        }
+        // black pieces
+        else
+        {
+            addOccupiedBitboard(black, m_pos.pieces[i]);
+        }
+    }
+
+    if (m_trackAttackMaps)
+        updateAttackMaps();
+}
+
+void Board::resetOccupiedBitboards()
+{
+    for (int i = 0; i < 3; ++i)
+        m_pos.occupied[i] = 0ULL;
+}
+
+void Board::resetBoard()
+{
+    for (int i = 0; i < 12; ++i)
+        m_pos.pieces[i] = 0ULL;
+
+    resetOccupiedBitboards();
+
+    m_pos.side = white;
+    m_pos.enPassant = noSquare;
+    m_pos.castle = allSide;
+    m_pos.halfMove = 0;
+    m_pos.fullMove = 1;
+
+    for (int square = 0; square < 64; ++square)
+        m_pieceOn[square] = noPiece;
+    m_key = zobristKeys.castle[allSide];
+
+    m_attackMap[white] = 0ULL;
+    m_attackMap[black] = 0ULL;
+
+    m_historySize = 0;
+}
+
+// castling rights that survive a move touching the square, the king and rook home squares clear theirs
+static constexpr int castlingRightsMask[64] = {
+     7, 15, 15, 15,  3, 15, 15, 11,
+    15, 15, 15, 15, 15, 15, 15, 15,
+    15, 15, 15, 15, 15, 15, 15, 15,
+    15, 15, 15, 15, 15, 15, 15, 15,
+    15, 15, 15, 15, 15, 15, 15, 15,
+    15, 15, 15, 15, 15, 15, 15, 15,
+    15, 15, 15, 15, 15, 15, 15, 15,
+    13, 15, 15, 15, 12, 15, 15, 14
+};
+
+void Board::setPieceBitboard(Board::PieceTypes pt, int square)
+{
+    if (getBit(m_pos.pieces[pt], square))
+        return;
+
+    setBit(m_pos.pieces[pt], square);
+    m_pieceOn[square] = (unsigned char)pt;
+    m_key ^= zobristKeys.pieces[pt][square];
+}
+
+void Board::popPieceBitboard(Board::PieceTypes pt, int square)
+{
+    if (!getBit(m_pos.pieces[pt], square))
+        return;
+
+    popBit(m_pos.pieces[pt], square);
+    m_pieceOn[square] = noPiece;
+    m_key ^= zobristKeys.pieces[pt][square];
+}
+
+U64 Board::computeKey() const
+{
+    U64 key = zobristKeys.castle[m_pos.castle] ^ getEnPassantKey(m_pos.enPassant);
+    if (m_pos.side == black)
+        key ^= zobristKeys.side;
+
+    for (int piece = whitePawn; piece <= blackKing; ++piece)
+    {
+        U64 bitboard = m_pos.pieces[piece];
+        while (bitboard)
+            key ^= zobristKeys.pieces[piece][popLSB(bitboard)];
+    }
+
+    return key;
+}
+
+void Board::makeMove(Move move)
+{
+    const int side = m_pos.side;
+    const int enemy = side ^ 1;
+    const int from = getMoveFrom(move);
+    const int to = getMoveTo(move);
+    const int flags = getMoveFlags(move);
+    const int piece = m_pieceOn[from];
+    const U64 fromTo = (1ULL << from) | (1ULL << to);
+
+    if (m_historySize == (int)m_history.size())
+        growHistory();
+    UndoState& undo = m_history[m_historySize++];
+    undo.key = m_key;
+    undo.move = move;
+    undo.movedPiece = (unsigned char)piece;
+    undo.capturedPiece = noPiece;
+    if (m_trackAttackMaps)
+    {
+        undo.attackMap[white] = m_attackMap[white];
+        undo.attackMap[black] = m_attackMap[black];
+    }
+    undo.castle = m_pos.castle;
+    undo.enPassant = m_pos.enPassant;
+    undo.halfMove = m_pos.halfMove;
+
+    m_pos.halfMove++;
+
+    // remove the captured piece, for en passant it sits behind the target square
+    if (isCaptureMove(move))
+    {
+        int captureSquare = flags == enPassantCapture ? (side == white ? to + 8 : to - 8) : to;
+        int captured = m_pieceOn[captureSquare];
+        U64 captureBit = 1ULL << captureSquare;
+
+        m_pos.pieces[captured] ^= captureBit;
+        m_pos.occupied[enemy] ^= captureBit;
+        m_pos.occupied[both] ^= captureBit;
+        m_pieceOn[captureSquare] = noPiece;
+        m_key ^= zobristKeys.pieces[captured][captureSquare];
+        undo.capturedPiece = (unsigned char)captured;
+        m_pos.halfMove = 0;
+    }
+
+    m_pos.pieces[piece] ^= fromTo;
+    m_pos.occupied[side] ^= fromTo;
+    m_pos.occupied[both] ^= fromTo;
+    m_pieceOn[from] = noPiece;
+    m_pieceOn[to] = (unsigned char)piece;
+    m_key ^= zobristKeys.pieces[piece][from] ^ zobristKeys.pieces[piece][to];
+
+    if (isPromotionMove(move))
+    {
+        int promoted = getPromotionPiece(move, side);
+        m_pos.pieces[piece] ^= 1ULL << to;
+        m_pos.pieces[promoted] ^= 1ULL << to;
+        m_pieceOn[to] = (unsigned char)promoted;
+        m_key ^= zobristKeys.pieces[piece][to] ^ zobristKeys.pieces[promoted][to];
+    }
+    else if (isCastlingMove(move))
+    {
+        // the rook jumps over the king: h-file to f-file, a-file to d-file
+        int rook = whiteRook + side;
+        int rookFrom = flags == kingCastle ? to + 1 : to - 2;
+        int rookTo = flags == kingCastle ? to - 1 : to + 1;
+        U64 rookFromTo = (1ULL << rookFrom) | (1ULL << rookTo);
+
+        m_pos.pieces[rook] ^= rookFromTo;
+        m_pos.occupied[side] ^= rookFromTo;
+        m_pos.occupied[both] ^= rookFromTo;
+        m_pieceOn[rookFrom] = noPiece;
+        m_pieceOn[rookTo] = (unsigned char)rook;
+        m_key ^= zobristKeys.pieces[rook][rookFrom] ^ zobristKeys.pieces[rook][rookTo];
+    }
+
+    if (piece == whitePawn + side)
+        m_pos.halfMove = 0;
+
+    int enPassant = flags == doublePawnPush ? (from + to) / 2 : noSquare;
+    m_key ^= getEnPassantKey(m_pos.enPassant) ^ getEnPassantKey(enPassant);
+    m_pos.enPassant = (signed char)enPassant;
+
+    int castle = m_pos.castle & castlingRightsMask[from] & castlingRightsMask[to];
+    m_key ^= zobristKeys.castle[m_pos.castle] ^ zobristKeys.castle[castle];
+    m_pos.castle = (unsigned char)castle;
+
+    m_pos.side ^= 1;
+    m_key ^= zobristKeys.side;
+    if (m_pos.side == white)
+        m_pos.fullMove++;
+
+    if (m_trackAttackMaps)
+        updateAttackMaps();
+}
+
+void Board::unmakeMove()
+{
+    const UndoState& undo = m_history[--m_historySize];
+    const Move move = undo.move;
+    const int flags = getMoveFlags(move);
+    const int from = getMoveFrom(move);
+    const int to = getMoveTo(move);
+    const U64 fromTo = (1ULL << from) | (1ULL << to);
+
+    if (m_pos.side == white)
+        m_pos.fullMove--;
+    m_pos.side ^= 1;
+
+    const int side = m_pos.side;
+    const int enemy = side ^ 1;
+
+    if (isPromotionMove(move))
+    {
+        m_pos.pieces[getPromotionPiece(move, side)] ^= 1ULL << to;
+        m_pos.pieces[undo.movedPiece] ^= 1ULL << to;
+    }
+    else if (isCastlingMove(move))
+    {
+        int rook = whiteRook + side;
+        int rookFrom = flags == kingCastle ? to + 1 : to - 2;
+        int rookTo = flags == kingCastle ? to - 1 : to + 1;
+        U64 rookFromTo = (1ULL << rookFrom) | (1ULL << rookTo);
+
+        m_pos.pieces[rook] ^= rookFromTo;
+        m_pos.occupied[side] ^= rookFromTo;
+        m_pos.occupied[both] ^= rookFromTo;
+        m_pieceOn[rookTo] = noPiece;
+        m_pieceOn[rookFrom] = (unsigned char)rook;
+    }
+
+    m_pos.pieces[undo.movedPiece] ^= fromTo;
+    m_pos.occupied[side] ^= fromTo;
+    m_pos.occupied[both] ^= fromTo;
+    m_pieceOn[to] = noPiece;
+    m_pieceOn[from] = undo.movedPiece;
+
+    if (undo.capturedPiece != noPiece)
+    {
+        int captureSquare = flags == enPassantCapture ? (side == white ? to + 8 : to - 8) : to;
+        U64 captureBit = 1ULL << captureSquare;
+
+        m_pos.pieces[undo.capturedPiece] ^= captureBit;
+        m_pos.occupied[enemy] ^= captureBit;
+        m_pos.occupied[both] ^= captureBit;
+        m_pieceOn[captureSquare] = undo.capturedPiece;
+    }
+
+    m_pos.castle = undo.castle;
+    m_pos.enPassant = undo.enPassant;
+    m_pos.halfMove = undo.halfMove;
+    m_key = undo.key;
+
+    if (m_trackAttackMaps)
+    {
+        m_attackMap[white] = undo.attackMap[white];
+        m_attackMap[black] = undo.attackMap[black];
+    }
+}
+
+void Board::growHistory()
+{
+    m_history.resize(m_history.empty() ? 256 : m_history.size() * 2);
+}
+
+bool Board::isRepetition() const
+{
+    // the same side moves every second ply, and nothing before the last irreversible move can come back
+    int first = m_historySize - m_pos.halfMove;
+    if (first < 0)
+        first = 0;
+
+    for (int i = m_historySize - 2; i >= first; i -= 2)
+    {
+        if (m_history[i].key == m_key)
+            return true;
+    }
+
+    return false;
+}
+
+// exchange values by piece type, the king is never actually traded
+static constexpr int seeValues[6] = { 100, 320, 330, 500, 900, 20000 };
+
+int Board::see(Move move) const
+{
+    const int from = getMoveFrom(move);
+    const int to = getMoveTo(move);
+    const U64 bishopsQueens = m_pos.pieces[whiteBishop] | m_pos.pieces[blackBishop] | m_pos.pieces[whiteQueen] | m_pos.pieces[blackQueen];
+    const U64 rooksQueens = m_pos.pieces[whiteRook] | m_pos.pieces[blackRook] | m_pos.pieces[whiteQueen] | m_pos.pieces[blackQueen];
+
+    int gain[32];
+    int depth = 0;
+    int side = m_pos.side;
+    int attacker = getPieceOn(from) >> 1;
+    U64 occ = m_pos.occupied[both] ^ (1ULL << from);
+
+    if (getMoveFlags(move) == enPassantCapture)
+    {
+        occ ^= 1ULL << (side == white ? to + 8 : to - 8);
+        gain[0] = seeValues[0];
+    }
+    else
+    {
+        int victim = getPieceOn(to);
+        gain[0] = victim != noPiece ? seeValues[victim >> 1] : 0;
+    }
+
+    // a promoting pawn stands on the square as the new piece
+    if (isPromotionMove(move))
+    {
+        attacker = getPromotionPiece(move, white) >> 1;
+        gain[0] += seeValues[attacker] - seeValues[0];
+    }
+
+    // sliders behind the pieces that already captured join in as the occupancy thins out
+    U64 attackers = attackersTo(to, occ) & occ;
+
+    while (true)
+    {
+        side ^= 1;
+        U64 sideAttackers = attackers & m_pos.occupied[side];
+        if (!sideAttackers)
+            break;
+
+        // least valuable attacker takes next
+        int piece = 0;
+        U64 pieceBitboard = 0ULL;
+        for (; piece < 6; ++piece)
+        {
+            pieceBitboard = sideAttackers & m_pos.pieces[2 * piece + side];
+            if (pieceBitboard)
+                break;
+        }
+
+        // the king can only take last
+        if (piece == 5 && (attackers & m_pos.occupied[side ^ 1]))
+            break;
+
+        depth++;
+        gain[depth] = seeValues[attacker] - gain[depth - 1];
+        attacker = piece;
+
+        occ ^= pieceBitboard & (0ULL - pieceBitboard);
+        if (piece == 0 || piece == 2 || piece == 4)
+            attackers |= getBishopAttackBitboard(occ, to) & bishopsQueens;
+        if (piece == 3 || piece == 4)
+            attackers |= getRookAttackBitboard(occ, to) & rooksQueens;
+        attackers &= occ;
+    }
+
+    // either side may stop capturing when going on would lose material
+    while (depth)
+    {
+        gain[depth - 1] = -(-gain[depth - 1] > gain[depth] ? -gain[depth - 1] : gain[depth]);
+        depth--;
+    }
+
+    return gain[0];
+}
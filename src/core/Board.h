@@ -0,0 +1,328 @@
+#pragma once
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#include "AttackTables.h"
+#include "BitOps.h"
+#include "Move.h"
+#include "Position.h"
+#include "SetwiseAttacks.h"
+#include "Zobrist.h"
+
+#define flipBit(bb, sq) ((bb) ^= (1ULL << (sq)))
+#define setBit(bb, sq) ((bb) |= (1ULL << (sq)))
+#define getBit(bb, sq) ((bb) & (1ULL << (sq)))
+#define popBit(bb, sq) (getBit((bb), (sq)) ? flipBit((bb), (sq)) : 0)
+
+#define startFEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"
+
+// what makeMove overwrites and unmakeMove can't recompute
+struct UndoState
+{
+    U64 key;
+    Move move;
+    unsigned char movedPiece;
+    unsigned char capturedPiece;
+    unsigned char castle;
+    signed char enPassant;
+    unsigned short halfMove;
+    // the attack maps before the move, only written while the board tracks them
+    U64 attackMap[2];
+};
+
+class Board
+{
+public:
+    enum BoardSquares {
+        a8, b8, c8, d8, e8, f8, g8, h8,
+        a7, b7, c7, d7, e7, f7, g7, h7,
+        a6, b6, c6, d6, e6, f6, g6, h6,
+        a5, b5, c5, d5, e5, f5, g5, h5,
+        a4, b4, c4, d4, e4, f4, g4, h4,
+        a3, b3, c3, d3, e3, f3, g3, h3,
+        a2, b2, c2, d2, e2, f2, g2, h2,
+        a1, b1, c1, d1, e1, f1, g1, h1,
+        noSquare = -1
+    };
+    enum PieceColors {
+        white,
+        black,
+        both
+    };
+    typedef PieceColors Color;
+    enum PieceTypes
+    {
+        whitePawn,
+        blackPawn,
+        whiteKnight,
+        blackKnight,
+        whiteBishop,
+        blackBishop,
+        whiteRook,
+        blackRook,
+        whiteQueen,
+        blackQueen,
+        whiteKing,
+        blackKing,
+        noPiece
+    };
+    // Castling Flags
+    // 0001 whiteKingSide
+    // 0010 whiteQueenSide
+    // 0100 blackKingSide
+    // 1000 blackQueenSide
+    // 1111 allSide
+    enum CastleFlags
+    {
+        none = 0,
+        whiteKingSide = 1,
+        whiteQueenSide = 2,
+        blackKingSide = 4,
+        blackQueenSide = 8,
+        allSide = 15
+    };
+
+    Board()
+    {
+        // initialize initial board state
+        resetBoard();
+
+        // initial pawns
+        setWhitePawns(a2);
+        setWhitePawns(b2);
+        setWhitePawns(c2);
+        setWhitePawns(d2);
+        setWhitePawns(e2);
+        setWhitePawns(f2);
+        setWhitePawns(g2);
+        setWhitePawns(h2);
+        setBlackPawns(a7);
+        setBlackPawns(b7);
+        setBlackPawns(c7);
+        setBlackPawns(d7);
+        setBlackPawns(e7);
+        setBlackPawns(f7);
+        setBlackPawns(g7);
+        setBlackPawns(h7);
+
+        // initial knights
+        setWhiteKnights(b1);
+        setWhiteKnights(g1);
+        setBlackKnights(b8);
+        setBlackKnights(g8);
+
+        // initial bishops
+        setWhiteBishops(c1);
+        setWhiteBishops(f1);
+        setBlackBishops(c8);
+        setBlackBishops(f8);
+
+        // initial rook
+        setWhiteRooks(a1);
+        setWhiteRooks(h1);
+        setBlackRooks(a8);
+        setBlackRooks(h8);
+
+        // initial queen
+        setWhiteQueens(d1);
+        setBlackQueens(d8);
+
+        // initial king
+        setWhiteKing(e1);
+        setBlackKing(e8);
+
+        updateOccupiedBitboards();
+    }
+
+    // piece possible attacks methods
+    static U64 getPawnAttackBitboard(int side, int square);
+    // whole pawn sets at once: single pushes, double pushes and the captures towards either file
+    template <Color Us>
+    static U64 getPawnPushBitboard(U64 pawns, U64 empty) { return (Us == white ? pawns >> 8 : pawns << 8) & empty; }
+    template <Color Us>
+    static U64 getPawnDoublePushBitboard(U64 pawns, U64 empty)
+    {
+        // pawns that got to the third rank with their single push may go one further
+        constexpr U64 thirdRank = Us == white ? 0x0000FF0000000000ULL : 0x0000000000FF0000ULL;
+        return getPawnPushBitboard<Us>(getPawnPushBitboard<Us>(pawns, empty) & thirdRank, empty);
+    }
+    template <Color Us>
+    static U64 getPawnWestCaptureBitboard(U64 pawns) { return Us == white ? (pawns & 0xFEFEFEFEFEFEFEFEULL) >> 9 : (pawns & 0xFEFEFEFEFEFEFEFEULL) << 7; }
+    template <Color Us>
+    static U64 getPawnEastCaptureBitboard(U64 pawns) { return Us == white ? (pawns & 0x7F7F7F7F7F7F7F7FULL) >> 7 : (pawns & 0x7F7F7F7F7F7F7F7FULL) << 9; }
+    static U64 getKnightAttackBitboard(int square);
+
+    static U64 getBishopMaskBitboard(int square);
+    static U64 getBishopAttackBitboardRuntime(U64 board, int square);
+    static U64 getBishopAttackBitboard(U64 occ, int square);
+    static U64 getBishopAttackBitboardMagic(U64 occ, int square);
+    static U64 getBishopAttackBitboardPext(U64 occ, int square);
+
+    static U64 getRookMaskBitboard(int square);
+    static U64 getRookAttackBitboardRuntime(U64 board, int square);
+    static U64 getRookAttackBitboard(U64 occ, int square);
+    static U64 getRookAttackBitboardMagic(U64 occ, int square);
+    static U64 getRookAttackBitboardPext(U64 occ, int square);
+
+    static U64 getQueenAttackBitboard(U64 occ, int square);
+    static U64 getKingAttackBitboard(int square);
+    // squares a non-pawn piece attacks, pawns get their captures
+    static U64 getPieceAttackBitboard(int piece, int square, U64 occ);
+
+    // attack queries
+    U64 attackersTo(int square, U64 occ) const;
+    U64 getSideAttacks(int side) const;
+    bool isSquareAttacked(int side, int square) const;
+    bool isAnySquareAttacked(int side, U64 squares) const;
+
+    // the same queries for one colour fixed at compile time, so the pawn direction folds into a constant
+    template <Color Them>
+    U64 getAttackersOf(int square, U64 occ) const
+    {
+        constexpr Color Us = Them == white ? black : white;
+
+        return (pawnAttackTable[Us][square] & m_pos.pieces[whitePawn + Them])
+            | (knightAttackTable[square] & m_pos.pieces[whiteKnight + Them])
+            | (kingAttackTable[square] & m_pos.pieces[whiteKing + Them])
+            | (getBishopAttackBitboard(occ, square) & (m_pos.pieces[whiteBishop + Them] | m_pos.pieces[whiteQueen + Them]))
+            | (getRookAttackBitboard(occ, square) & (m_pos.pieces[whiteRook + Them] | m_pos.pieces[whiteQueen + Them]));
+    }
+    template <Color Them>
+    bool isAnySquareAttacked(U64 squares) const
+    {
+        if (m_trackAttackMaps)
+            return (m_attackMap[Them] & squares) != 0;
+
+        while (squares)
+        {
+            if (getAttackersOf<Them>(popLSB(squares), m_pos.occupied[both]))
+                return true;
+        }
+
+        return false;
+    }
+    // static exchange evaluation, material won or lost by the capture sequence on the target square
+    int see(Move move) const;
+    bool isInCheck(int side) const { return isSquareAttacked(!side, getLSB(m_pos.pieces[whiteKing + side])); }
+
+    // play and take back moves, updating only the bitboards a move touches
+    void makeMove(Move move);
+    void unmakeMove();
+    int getHistorySize() const { return m_historySize; }
+    // the position occurred before with the same side to move since the last capture or pawn move
+    bool isRepetition() const;
+
+    // move generation for the side to move, fills a stack allocated list without touching the heap
+    void generatePseudoLegalMoves(MoveList& moveList, MoveGenType type = allMoves) const;
+    bool isPseudoLegal(Move move) const;
+    // only legal moves, from check and pin masks computed once instead of making and testing every move
+    void generateLegalMoves(MoveList& moveList) const;
+    U64 getCheckers() const;
+    U64 getPinnedPieces(int side) const;
+    template <Color Us>
+    U64 getPinnedPieces() const;
+
+    // optional per side attack maps; makeMove rebuilds both in full with the setwise fills rather than
+    // patching the squares the move touched, and unmakeMove restores the saved ones. That costs more per
+    // move than answering the odd attack query on demand, so it only pays off when a position gets many
+    // queries, and it stays off unless asked for. Turn it on before making moves, unmakeMove relies on
+    // the maps saved while it was on
+    void setAttackMapTracking(bool enabled);
+    bool isTrackingAttackMaps() const { return m_trackAttackMaps; }
+    U64 getAttackMap(int side) const { return m_attackMap[side]; }
+    void updateAttackMaps();
+
+    static U64 setOccupancy(U64 maskBitboard, int index, int maskBitCount);
+    static void printBitboard(U64 bitboard);
+
+    // getters
+    U64 getEmptyBitboard() const { return ~m_pos.occupied[both]; };
+    U64 getOccupiedBitboard(int side) const { return m_pos.occupied[side]; };
+
+    U64 getPieceBitboard(int pt) const { return m_pos.pieces[pt]; };
+    U64 getWhitePawns() const { return m_pos.pieces[whitePawn]; }
+    U64 getBlackPawns() const { return m_pos.pieces[blackPawn]; }
+    U64 getWhiteKnights() const { return m_pos.pieces[whiteKnight]; }
+    U64 getBlackKnights() const { return m_pos.pieces[blackKnight]; }
+    U64 getWhiteBishops() const { return m_pos.pieces[whiteBishop]; }
+    U64 getBlackBishops() const { return m_pos.pieces[blackBishop]; }
+    U64 getWhiteRooks() const { return m_pos.pieces[whiteRook]; }
+    U64 getBlackRooks() const { return m_pos.pieces[blackRook]; }
+    U64 getWhiteQueens() const { return m_pos.pieces[whiteQueen]; }
+    U64 getBlackQueens() const { return m_pos.pieces[blackQueen]; }
+    U64 getWhiteKing() const { return m_pos.pieces[whiteKing]; }
+    U64 getBlackKing() const { return m_pos.pieces[blackKing]; }
+    int getPieceOn(int square) const { return m_pieceOn[square]; }
+    U64 getKey() const { return m_key; }
+    // the hash recomputed from scratch, getKey() is kept equal to it incrementally
+    U64 computeKey() const;
+    int getSide() const { return m_pos.side; }
+    int getEnPassantSquare() const { return m_pos.enPassant; }
+    int getCastlingRights() const { return m_pos.castle; }
+    int getHalfMoveClock() const { return m_pos.halfMove; }
+    int getFullMoveNumber() const { return m_pos.fullMove; }
+    const Position& getPosition() const { return m_pos; }
+
+    // setters
+    void addOccupiedBitboard(int side, U64 bitboard) { m_pos.occupied[side] |= bitboard; };
+    void setOccupiedBitboardSquare(int side, int square) { setBit(m_pos.occupied[side], square); };
+    void clearOccupiedBitboardSquare(int side, int square) { popBit(m_pos.occupied[side], square); };
+    void updateOccupiedBitboards();
+    void resetOccupiedBitboards();
+    void resetBoard();
+
+    // piece setters keep the mailbox and the hash key in sync with the bitboards
+    void setPieceBitboard(Board::PieceTypes pt, int square);
+    void popPieceBitboard(Board::PieceTypes pt, int square);
+    void setWhitePawns(int square) { setPieceBitboard(whitePawn, square); }
+    void setBlackPawns(int square) { setPieceBitboard(blackPawn, square); }
+    void setWhiteKnights(int square) { setPieceBitboard(whiteKnight, square); }
+    void setBlackKnights(int square) { setPieceBitboard(blackKnight, square); }
+    void setWhiteBishops(int square) { setPieceBitboard(whiteBishop, square); }
+    void setBlackBishops(int square) { setPieceBitboard(blackBishop, square); }
+    void setWhiteRooks(int square) { setPieceBitboard(whiteRook, square); }
+    void setBlackRooks(int square) { setPieceBitboard(blackRook, square); }
+    void setWhiteQueens(int square) { setPieceBitboard(whiteQueen, square); }
+    void setBlackQueens(int square) { setPieceBitboard(blackQueen, square); }
+    void setWhiteKing(int square) { setPieceBitboard(whiteKing, square); }
+    void setBlackKing(int square) { setPieceBitboard(blackKing, square); }
+    void setSide(bool side) { if (side != (m_pos.side != 0)) m_key ^= zobristKeys.side; m_pos.side = side; }
+    void setEnPassantSquare(int square) { m_key ^= getEnPassantKey(m_pos.enPassant) ^ getEnPassantKey(square); m_pos.enPassant = (signed char)square; }
+    void setCastlingRights(int flags) { m_key ^= zobristKeys.castle[m_pos.castle] ^ zobristKeys.castle[flags]; m_pos.castle = (unsigned char)flags; }
+    void setHalfMoveClock(int halfMove) { m_pos.halfMove = (unsigned short)halfMove; }
+    void setFullMoveNumber(int fullMove) { m_pos.fullMove = (unsigned short)fullMove; }
+
+    void flipSide() { m_pos.side ^= 1; m_key ^= zobristKeys.side; setEnPassantSquare(noSquare); }
+
+private:
+    // generation for one colour, the public functions dispatch on the side to move once per call
+    template <Color Us>
+    void generatePseudoLegalMoves(MoveList& moveList, MoveGenType type) const;
+    template <Color Us>
+    void generateLegalMoves(MoveList& moveList) const;
+    template <Color Us>
+    void generatePieceMoves(MoveList& moveList, U64 checkMask, U64 pinned, bool legal, MoveGenType type) const;
+    template <Color Us>
+    void generatePawnMoves(MoveList& moveList, U64 checkMask, U64 pinned, bool legal, MoveGenType type) const;
+    template <Color Us>
+    void addPawnMoves(MoveList& moveList, U64 pawns, U64 allowed, MoveGenType type) const;
+    template <Color Us>
+    void generateCastlingMoves(MoveList& moveList) const;
+    // makes room for more undo entries, kept out of makeMove's fast path
+    void growHistory();
+
+    Position m_pos;
+    // what stands on every square, noPiece when empty
+    unsigned char m_pieceOn[64];
+    U64 m_key;
+    U64 m_attackMap[2] = {};
+    bool m_trackAttackMaps = false;
+
+    // the undo stack lives on the heap and grows with the game, so constructing or copying a Board stays
+    // cheap and no game is too long for it; the Position alone is still the thing to copy when only the
+    // game state is needed
+    std::vector<UndoState> m_history;
+    int m_historySize = 0;
+};
@@ -0,0 +1,98 @@
+#include "CpuFeatures.h"
+
+#include <string.h>
+
+#if defined(PEXT_BACKEND_AVAILABLE)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+struct CpuFeatures
+{
+    bool hasPext;
+    bool hasFastPext;
+    bool hasAvx2;
+};
+
+static void cpuid(unsigned int leaf, unsigned int subleaf, unsigned int regs[4])
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuidex(info, (int)leaf, (int)subleaf);
+    for (int i = 0; i < 4; ++i)
+        regs[i] = (unsigned int)info[i];
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+static CpuFeatures readCpuFeatures()
+{
+    CpuFeatures features = { false, false, false };
+
+#if defined(PEXT_BACKEND_AVAILABLE)
+    unsigned int regs[4] = { 0, 0, 0, 0 };
+    char vendor[13] = { 0 };
+
+    cpuid(0, 0, regs);
+    unsigned int maxLeaf = regs[0];
+    memcpy(vendor + 0, &regs[1], 4);
+    memcpy(vendor + 4, &regs[3], 4);
+    memcpy(vendor + 8, &regs[2], 4);
+    if (maxLeaf < 7)
+        return features;
+
+    cpuid(1, 0, regs);
+    unsigned int signature = regs[0];
+    // the OS has to save the ymm registers on context switches (OSXSAVE + XCR0 bits 1 and 2)
+    bool osSavesYmm = false;
+    if ((regs[2] >> 27) & 1)
+    {
+#if defined(_MSC_VER)
+        unsigned long long xcr0 = _xgetbv(0);
+#else
+        unsigned int xcr0Low, xcr0High;
+        __asm__("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+        unsigned long long xcr0 = ((unsigned long long)xcr0High << 32) | xcr0Low;
+#endif
+        osSavesYmm = (xcr0 & 6) == 6;
+    }
+
+    // CPUID.(EAX=7,ECX=0):EBX bit 5 is AVX2, bit 8 is BMI2
+    cpuid(7, 0, regs);
+    features.hasAvx2 = osSavesYmm && ((regs[1] >> 5) & 1);
+    features.hasPext = (regs[1] >> 8) & 1;
+
+    // AMD implements pext in microcode before family 19h (Zen 3), slower than a magic multiply
+    unsigned int family = (signature >> 8) & 0xF;
+    if (family == 0xF)
+        family += (signature >> 20) & 0xFF;
+    features.hasFastPext = features.hasPext && !(strcmp(vendor, "AuthenticAMD") == 0 && family < 0x19);
+#endif
+
+    return features;
+}
+
+static const CpuFeatures& getCpuFeatures()
+{
+    static const CpuFeatures features = readCpuFeatures();
+    return features;
+}
+
+bool cpuHasPext()
+{
+    return getCpuFeatures().hasPext;
+}
+
+bool cpuHasFastPext()
+{
+    return getCpuFeatures().hasFastPext;
+}
+
+bool cpuHasAvx2()
+{
+    return getCpuFeatures().hasAvx2;
+}
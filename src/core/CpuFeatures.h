@@ -0,0 +1,20 @@
+#pragma once
+
+// BMI2 and AVX2 code paths can only be compiled in on x86-64, they are picked at runtime
+#if defined(__x86_64__) || defined(_M_X64)
+#define PEXT_BACKEND_AVAILABLE 1
+#define AVX2_FILL_AVAILABLE 1
+#if defined(_MSC_VER)
+#define PEXT_TARGET
+#define AVX2_TARGET
+#else
+#define PEXT_TARGET __attribute__((target("bmi2")))
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
+// BMI2 support, and whether pext is also fast (not microcoded as on AMD before Zen 3)
+bool cpuHasPext();
+bool cpuHasFastPext();
+// AVX2 support including OS support for the ymm registers
+bool cpuHasAvx2();
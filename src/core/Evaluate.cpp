@@ -0,0 +1,121 @@
+#include "Evaluate.h"
+
+// how much each piece type counts towards the middlegame, a full set of pieces adds up to 24
+static const int phaseWeights[6] = { 0, 1, 1, 2, 4, 0 };
+static const int maxPhase = 24;
+
+// bonuses for white from a8 to h1, black reads them mirrored through square ^ 56
+static const int pieceSquareTables[6][64] = {
+    // pawn
+    {
+          0,   0,   0,   0,   0,   0,   0,   0,
+         50,  50,  50,  50,  50,  50,  50,  50,
+         10,  10,  20,  30,  30,  20,  10,  10,
+          5,   5,  10,  25,  25,  10,   5,   5,
+          0,   0,   0,  20,  20,   0,   0,   0,
+          5,  -5, -10,   0,   0, -10,  -5,   5,
+          5,  10,  10, -20, -20,  10,  10,   5,
+          0,   0,   0,   0,   0,   0,   0,   0
+    },
+    // knight
+    {
+        -50, -40, -30, -30, -30, -30, -40, -50,
+        -40, -20,   0,   0,   0,   0, -20, -40,
+        -30,   0,  10,  15,  15,  10,   0, -30,
+        -30,   5,  15,  20,  20,  15,   5, -30,
+        -30,   0,  15,  20,  20,  15,   0, -30,
+        -30,   5,  10,  15,  15,  10,   5, -30,
+        -40, -20,   0,   5,   5,   0, -20, -40,
+        -50, -40, -30, -30, -30, -30, -40, -50
+    },
+    // bishop
+    {
+        -20, -10, -10, -10, -10, -10, -10, -20,
+        -10,   0,   0,   0,   0,   0,   0, -10,
+        -10,   0,   5,  10,  10,   5,   0, -10,
+        -10,   5,   5,  10,  10,   5,   5, -10,
+        -10,   0,  10,  10,  10,  10,   0, -10,
+        -10,  10,  10,  10,  10,  10,  10, -10,
+        -10,   5,   0,   0,   0,   0,   5, -10,
+        -20, -10, -10, -10, -10, -10, -10, -20
+    },
+    // rook
+    {
+          0,   0,   0,   0,   0,   0,   0,   0,
+          5,  10,  10,  10,  10,  10,  10,   5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+          0,   0,   0,   5,   5,   0,   0,   0
+    },
+    // queen
+    {
+        -20, -10, -10,  -5,  -5, -10, -10, -20,
+        -10,   0,   0,   0,   0,   0,   0, -10,
+        -10,   0,   5,   5,   5,   5,   0, -10,
+         -5,   0,   5,   5,   5,   5,   0,  -5,
+          0,   0,   5,   5,   5,   5,   0,  -5,
+        -10,   5,   5,   5,   5,   5,   0, -10,
+        -10,   0,   5,   0,   0,   0,   0, -10,
+        -20, -10, -10,  -5,  -5, -10, -10, -20
+    },
+    // king in the middlegame, stay behind the pawns
+    {
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -20, -30, -30, -40, -40, -30, -30, -20,
+        -10, -20, -20, -20, -20, -20, -20, -10,
+         20,  20,   0,   0,   0,   0,  20,  20,
+         20,  30,  10,   0,   0,  10,  30,  20
+    }
+};
+
+// king in the endgame, head for the centre
+static const int kingEndgameTable[64] = {
+    -50, -40, -30, -20, -20, -30, -40, -50,
+    -30, -20, -10,   0,   0, -10, -20, -30,
+    -30, -10,  20,  30,  30,  20, -10, -30,
+    -30, -10,  30,  40,  40,  30, -10, -30,
+    -30, -10,  30,  40,  40,  30, -10, -30,
+    -30, -10,  20,  30,  30,  20, -10, -30,
+    -30, -30,   0,   0,   0,   0, -30, -30,
+    -50, -30, -30, -30, -30, -30, -30, -50
+};
+
+int evaluate(const Board& board)
+{
+    const Position& pos = board.getPosition();
+
+    // everything but the king scores the same in both phases
+    int score = 0;
+    int phase = 0;
+    for (int piece = Board::whitePawn; piece < Board::whiteKing; ++piece)
+    {
+        int type = piece >> 1;
+        int sign = (piece & 1) == Board::white ? 1 : -1;
+        int flip = (piece & 1) == Board::white ? 0 : 56;
+
+        U64 pieces = pos.pieces[piece];
+        while (pieces)
+        {
+            int square = popLSB(pieces);
+            score += sign * (pieceValues[type] + pieceSquareTables[type][square ^ flip]);
+            phase += phaseWeights[type];
+        }
+    }
+
+    if (phase > maxPhase)
+        phase = maxPhase;
+
+    int whiteKing = getLSB(pos.pieces[Board::whiteKing]);
+    int blackKing = getLSB(pos.pieces[Board::blackKing]) ^ 56;
+    int kingMiddlegame = pieceSquareTables[5][whiteKing] - pieceSquareTables[5][blackKing];
+    int kingEndgame = kingEndgameTable[whiteKing] - kingEndgameTable[blackKing];
+    score += (kingMiddlegame * phase + kingEndgame * (maxPhase - phase)) / maxPhase;
+
+    return board.getSide() == Board::white ? score : -score;
+}
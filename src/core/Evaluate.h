@@ -0,0 +1,10 @@
+#pragma once
+
+#include "Board.h"
+
+// piece values by piece type, pawn to king
+constexpr int pieceValues[6] = { 100, 320, 330, 500, 900, 0 };
+
+// material and piece-square tables, the king table blends from middlegame to endgame as pieces come off
+// the board; returns centipawns from the point of view of the side to move
+int evaluate(const Board& board);
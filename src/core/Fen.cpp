@@ -0,0 +1,286 @@
+#include "Fen.h"
+
+#include <ctype.h>
+#include <stdlib.h>
+
+static bool isFieldEnd(char c)
+{
+    return c == '\0' || isspace((unsigned char)c);
+}
+
+static const char* skipSpaces(const char* text)
+{
+    while (*text && isspace((unsigned char)*text))
+        text++;
+    return text;
+}
+
+// reads a move counter field and the whitespace after it, counters have to fit the 16 bits Position keeps
+static bool parseCounter(const char** text, int* value)
+{
+    char* end;
+    long number = strtol(*text, &end, 10);
+    if (end == *text || !isFieldEnd(*end) || number < 0 || number > 65535)
+        return false;
+
+    *value = (int)number;
+    *text = skipSpaces(end);
+    return true;
+}
+
+bool parseFEN(Board* board, const char* fen)
+{
+    // init piece placement
+    int i = 0;
+    for (int square = 0; square < 64; ++i)
+    {
+        // if current character is an alphabet, set pieces accordingly
+        if ((fen[i] >= 'a' && fen[i] <= 'z') || (fen[i] >= 'A' && fen[i] <= 'Z'))
+        {
+            switch (fen[i])
+            {
+                case 'p':
+                    // black rook
+                    board->setBlackPawns(square);
+                    board->setOccupiedBitboardSquare(board->black, square);
+                    board->setOccupiedBitboardSquare(board->both, square);
+                    square += 1;
+                    break;
+                case 'n':
+                    // black knight
+                    board->setBlackKnights(square);
+                    board->setOccupiedBitboardSquare(board->black, square);
+                    board->setOccupiedBitboardSquare(board->both, square);
+                    square += 1;
+                    break;
+                case 'b':
+                    // black bishop
+                    board->setBlackBishops(square);
+                    board->setOccupiedBitboardSquare(board->black, square);
+                    board->setOccupiedBitboardSquare(board->both, square);
+                    square += 1;
+                    break;
+                case 'r':
+                    // black rook
+                    board->setBlackRooks(square);
+                    board->setOccupiedBitboardSquare(board->black, square);
+                    board->setOccupiedBitboardSquare(board->both, square);
+                    square += 1;
+                    break;
+                case 'q':
+                    // black queen
+                    board->setBlackQueens(square);
+                    board->setOccupiedBitboardSquare(board->black, square);
+                    board->setOccupiedBitboardSquare(board->both, square);
+                    square += 1;
+                    break;
+                case 'k':
+                    // black king
+                    board->setBlackKing(square);
+                    board->setOccupiedBitboardSquare(board->black, square);
+                    board->setOccupiedBitboardSquare(board->both, square);
+                    square += 1;
+                    break;
+                case 'P':
+                    // white pawn
+                    board->setWhitePawns(square);
+                    board->setOccupiedBitboardSquare(board->white, square);
+                    board->setOccupiedBitboardSquare(board->both, square);
+                    square += 1;
+                    break;
+                case 'N':
+                    // white knight
+                    board->setWhiteKnights(square);
+                    board->setOccupiedBitboardSquare(board->white, square);
+                    board->setOccupiedBitboardSquare(board->both, square);
+                    square += 1;
+                    break;
+                case 'B':
+                    // white bishop
+                    board->setWhiteBishops(square);
+                    board->setOccupiedBitboardSquare(board->white, square);
+                    board->setOccupiedBitboardSquare(board->both, square);
+                    square += 1;
+                    break;
+                case 'R':
+                    // white rook
+                    board->setWhiteRooks(square);
+                    board->setOccupiedBitboardSquare(board->white, square);
+                    board->setOccupiedBitboardSquare(board->both, square);
+                    square += 1;
+                    break;
+                case 'Q':
+                    // white queen
+                    board->setWhiteQueens(square);
+                    board->setOccupiedBitboardSquare(board->white, square);
+                    board->setOccupiedBitboardSquare(board->both, square);
+                    square += 1;
+                    break;
+                case 'K':
+                    // white king
+                    board->setWhiteKing(square);
+                    board->setOccupiedBitboardSquare(board->white, square);
+                    board->setOccupiedBitboardSquare(board->both, square);
+                    square += 1;
+                    break;
+                default:
+                    return false;
+            }
+        }
+        else if (fen[i] >= '0' && fen[i] <= '9')
+        {
+            int numEmpty = fen[i] - '0';
+            square += numEmpty;
+        }
+        else if (fen[i] == '/')
+        {
+            continue;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    // also refreshes the attack maps when the board tracks them
+    board->updateOccupiedBitboards();
+
+    // the remaining fields are separated by any run of whitespace
+    const char* text = skipSpaces(fen + i);
+
+    // init side
+    int side;
+    if (*text == 'w')
+        side = board->white;
+    else if (*text == 'b')
+        side = board->black;
+    else
+        return false;
+    board->setSide(side);
+    text += 1;
+    if (!isFieldEnd(*text))
+        return false;
+    text = skipSpaces(text);
+
+    // init castling rights
+    int castleFlags = board->none;
+    for (; !isFieldEnd(*text); ++text)
+    {
+        switch (*text)
+        {
+            case 'K':
+                castleFlags |= board->whiteKingSide;
+                break;
+            case 'Q':
+                castleFlags |= board->whiteQueenSide;
+                break;
+            case 'k':
+                castleFlags |= board->blackKingSide;
+                break;
+            case 'q':
+                castleFlags |= board->blackQueenSide;
+                break;
+            case '-':
+                break;
+            default:
+                return false;
+        }
+    }
+    board->setCastlingRights(castleFlags);
+    text = skipSpaces(text);
+
+    // init en passant target square, behind a pawn of the side that just moved
+    if (*text == '-')
+    {
+        board->setEnPassantSquare(board->noSquare);
+        text += 1;
+    }
+    else
+    {
+        if (text[0] < 'a' || text[0] > 'h' || text[1] != (side == board->white ? '6' : '3'))
+            return false;
+        board->setEnPassantSquare(8 * ('8' - text[1]) + (text[0] - 'a'));
+        text += 2;
+    }
+    if (!isFieldEnd(*text))
+        return false;
+    text = skipSpaces(text);
+
+    // the move counters are optional, EPD style positions end after the en passant square
+    if (*text == '\0')
+        return true;
+
+    int halfMove;
+    if (!parseCounter(&text, &halfMove))
+        return false;
+    board->setHalfMoveClock(halfMove);
+
+    if (*text == '\0')
+        return true;
+
+    int fullMove;
+    if (!parseCounter(&text, &fullMove))
+        return false;
+    board->setFullMoveNumber(fullMove);
+
+    return true;
+}
+
+void getFEN(const Board& board, char* buffer)
+{
+    static const char pieceChars[] = "PpNnBbRrQqKk";
+
+    // piece placement from a8 to h1, runs of empty squares become digits
+    char* out = buffer;
+    for (int rank = 0; rank < 8; ++rank)
+    {
+        int emptyCount = 0;
+        for (int file = 0; file < 8; ++file)
+        {
+            int piece = board.getPieceOn(rank * 8 + file);
+            if (piece == Board::noPiece)
+            {
+                emptyCount++;
+                continue;
+            }
+
+            if (emptyCount)
+                *out++ = (char)('0' + emptyCount);
+            emptyCount = 0;
+            *out++ = pieceChars[piece];
+        }
+        if (emptyCount)
+            *out++ = (char)('0' + emptyCount);
+        if (rank < 7)
+            *out++ = '/';
+    }
+
+    *out++ = ' ';
+    *out++ = board.getSide() == Board::white ? 'w' : 'b';
+    *out++ = ' ';
+
+    int castle = board.getCastlingRights();
+    if (castle & Board::whiteKingSide)
+        *out++ = 'K';
+    if (castle & Board::whiteQueenSide)
+        *out++ = 'Q';
+    if (castle & Board::blackKingSide)
+        *out++ = 'k';
+    if (castle & Board::blackQueenSide)
+        *out++ = 'q';
+    if (!castle)
+        *out++ = '-';
+    *out++ = ' ';
+
+    int enPassant = board.getEnPassantSquare();
+    if (enPassant == Board::noSquare)
+    {
+        *out++ = '-';
+    }
+    else
+    {
+        *out++ = (char)('a' + enPassant % 8);
+        *out++ = (char)('8' - enPassant / 8);
+    }
+
+    sprintf(out, " %d %d", board.getHalfMoveClock(), board.getFullMoveNumber());
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "Board.h"
+
+// sets up a board from a FEN string, the board has to be reset first; fields may be separated by any
+// whitespace and the halfmove clock and fullmove number may be left out. Returns false on malformed
+// fields, including an en passant square on the wrong rank for the side to move
+bool parseFEN(Board* board, const char* fen);
+
+// writes the position as a FEN string, buffer needs room for 90 characters
+void getFEN(const Board& board, char* buffer);
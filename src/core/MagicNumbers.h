@@ -0,0 +1,163 @@
+// Generated by src/tools/magic_finder, regenerate instead of editing by hand.
+// bishop table: 5248 entries, rook table: 102400 entries, 841 KB in total
+#pragma once
+
+#include "BitOps.h"
+
+// magic multipliers of the slider tables
+inline constexpr U64 bishopMagicNumbers[64] = {
+    0x10102002004a1420ULL,
+    0xe004208a204220ULL,
+    0x41010200800020ULL,
+    0x1220a0201000400ULL,
+    0x202100a100200ULL,
+    0x80882008211068ULL,
+    0x2021004844000ULL,
+    0x8032010082100200ULL,
+    0x840502022288218ULL,
+    0xc404204010a020bULL,
+    0x214440408c820ULL,
+    0x82088200800ULL,
+    0x8100c11140020042ULL,
+    0x4202008804401080ULL,
+    0x800420201044000ULL,
+    0x80088208922000ULL,
+    0x6011010024800ULL,
+    0x4020201125022181ULL,
+    0xd141000208010100ULL,
+    0x800802004001ULL,
+    0x1224002294200521ULL,
+    0x200800040504008ULL,
+    0x82820201a002ULL,
+    0x4a1010444209400ULL,
+    0x904600010c21044ULL,
+    0xd58480002020830ULL,
+    0x4188012802020200ULL,
+    0x2002002002008200ULL,
+    0x810040008802100ULL,
+    0x1004c804821004ULL,
+    0x21620009009000ULL,
+    0x2400604021010800ULL,
+    0x4202020446420ULL,
+    0x24c420a04181010ULL,
+    0x144021100080240ULL,
+    0x2002820081080080ULL,
+    0x4440010010310040ULL,
+    0xb020010040420800ULL,
+    0x6310033945210c08ULL,
+    0xc088010244010050ULL,
+    0x180862100508a0ULL,
+    0x4020441088000404ULL,
+    0x8402410000100ULL,
+    0x141002018088101ULL,
+    0x2400a10214000a02ULL,
+    0x80420c889000200ULL,
+    0x184700430428110ULL,
+    0x408008820a904ULL,
+    0x80482410088040ULL,
+    0xc0a110422024008ULL,
+    0x4700004200900000ULL,
+    0xc001084041000ULL,
+    0x800210020e0000ULL,
+    0x500610411061108ULL,
+    0x110041000823210ULL,
+    0x7a00c0112610900ULL,
+    0x110828040400ULL,
+    0x4021820042021088ULL,
+    0x8040004200840420ULL,
+    0xc00004844420210ULL,
+    0x8000000020042410ULL,
+    0x6005884900a0a0cULL,
+    0x8108c51044c04ULL,
+    0x810600200820010ULL
+};
+inline constexpr U64 rookMagicNumbers[64] = {
+    0xa00104201008020ULL,
+    0x440004010002000ULL,
+    0x8801000a0008982ULL,
+    0x200120040082004ULL,
+    0x4e00140200102038ULL,
+    0xa100010004000208ULL,
+    0x42000110b2000804ULL,
+    0x200020021009044ULL,
+    0x282800040028220ULL,
+    0x820802000400082ULL,
+    0x4802000801000ULL,
+    0x4001000820100500ULL,
+    0x2001800400810800ULL,
+    0x283002209000400ULL,
+    0x43001100040200ULL,
+    0x1000082004100ULL,
+    0x9080208000400088ULL,
+    0x1000404000201004ULL,
+    0x91010010402001ULL,
+    0x808010000802ULL,
+    0x65510004680100ULL,
+    0xa080110044020ULL,
+    0x40021089022ULL,
+    0x8802002108844cULL,
+    0x80c0008480034062ULL,
+    0x611008200482200ULL,
+    0x4028100080200080ULL,
+    0x210100081000ULL,
+    0x80b8005100090084ULL,
+    0x1004040080800200ULL,
+    0x8800020400500108ULL,
+    0x5599040200004091ULL,
+    0x2c80004000c02000ULL,
+    0x10022001400040ULL,
+    0x411002001004010ULL,
+    0x3008084012002200ULL,
+    0x5880800400800800ULL,
+    0x1001000401000208ULL,
+    0x42800100808200ULL,
+    0x2008004402000081ULL,
+    0x3001804000218008ULL,
+    0x2020004000810100ULL,
+    0xa0001000208080ULL,
+    0x200080010008080ULL,
+    0x4000800808004ULL,
+    0x40002008080ULL,
+    0x5210208240010ULL,
+    0x100004100820004ULL,
+    0x400802100420200ULL,
+    0x1300410080220200ULL,
+    0x10a00100419100ULL,
+    0x8100800800100280ULL,
+    0x3157000410480300ULL,
+    0x2000428100600ULL,
+    0x2804900218412400ULL,
+    0x10046884010200ULL,
+    0x4001430068108001ULL,
+    0x840208306004016ULL,
+    0x8102104008220082ULL,
+    0x40821001001ULL,
+    0x8026000410200802ULL,
+    0x82007001880402ULL,
+    0x482a112802109004ULL,
+    0x20110644240282ULL
+};
+
+// index bits of each magic, fewer bits than the mask has means the magic
+// lets occupancies with identical attacks share a table entry
+inline constexpr int bishopRelevantBitCount[64] = {
+    6, 5, 5, 5, 5, 5, 5, 6,
+    5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 7, 7, 7, 7, 5, 5,
+    5, 5, 7, 9, 9, 7, 5, 5,
+    5, 5, 7, 9, 9, 7, 5, 5,
+    5, 5, 7, 7, 7, 7, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5,
+    6, 5, 5, 5, 5, 5, 5, 6,
+};
+
+inline constexpr int rookRelevantBitCount[64] = {
+    12, 11, 11, 11, 11, 11, 11, 12,
+    11, 10, 10, 10, 10, 10, 10, 11,
+    11, 10, 10, 10, 10, 10, 10, 11,
+    11, 10, 10, 10, 10, 10, 10, 11,
+    11, 10, 10, 10, 10, 10, 10, 11,
+    11, 10, 10, 10, 10, 10, 10, 11,
+    11, 10, 10, 10, 10, 10, 10, 11,
+    12, 11, 11, 11, 11, 11, 11, 12,
+};
@@ -0,0 +1,91 @@
+#pragma once
+
+// a move packed into 16 bits
+//   bits  0-5   from square
+//   bits  6-11  to square
+//   bits 12-15  flags
+typedef unsigned short Move;
+
+// Move Flags
+// 0000 quiet move
+// 0001 double pawn push
+// 0010 king side castling
+// 0011 queen side castling
+// 0100 capture
+// 0101 en passant capture
+// 1000 - 1011 knight, bishop, rook, queen promotion
+// 1100 - 1111 knight, bishop, rook, queen promotion with capture
+enum MoveFlags
+{
+    quietMove = 0,
+    doublePawnPush = 1,
+    kingCastle = 2,
+    queenCastle = 3,
+    captureFlag = 4,
+    enPassantCapture = 5,
+    knightPromotion = 8,
+    bishopPromotion = 9,
+    rookPromotion = 10,
+    queenPromotion = 11,
+    knightPromotionCapture = 12,
+    bishopPromotionCapture = 13,
+    rookPromotionCapture = 14,
+    queenPromotionCapture = 15
+};
+
+// a8a8 can never be played, so zero doubles as "no move"
+constexpr Move noMove = 0;
+
+constexpr Move encodeMove(int from, int to, int flags) { return (Move)(from | (to << 6) | (flags << 12)); }
+constexpr int getMoveFrom(Move move) { return move & 0x3F; }
+constexpr int getMoveTo(Move move) { return (move >> 6) & 0x3F; }
+constexpr int getMoveFlags(Move move) { return move >> 12; }
+constexpr bool isCaptureMove(Move move) { return (move & 0x4000) != 0; }
+constexpr bool isPromotionMove(Move move) { return (move & 0x8000) != 0; }
+constexpr bool isCastlingMove(Move move) { return getMoveFlags(move) == kingCastle || getMoveFlags(move) == queenCastle; }
+
+// knight, bishop, rook or queen of the given side, matching Board::PieceTypes
+constexpr int getPromotionPiece(Move move, int side) { return 2 + 2 * ((move >> 12) & 3) + side; }
+
+// long algebraic notation as used by UCI, e2e4 or e7e8q; the buffer needs room for 6 chars
+inline void getMoveString(Move move, char* buffer)
+{
+    const char promotionPieces[4] = { 'n', 'b', 'r', 'q' };
+    int from = getMoveFrom(move);
+    int to = getMoveTo(move);
+
+    // square 0 is a8
+    buffer[0] = (char)('a' + from % 8);
+    buffer[1] = (char)('8' - from / 8);
+    buffer[2] = (char)('a' + to % 8);
+    buffer[3] = (char)('8' - to / 8);
+    buffer[4] = isPromotionMove(move) ? promotionPieces[(move >> 12) & 3] : '\0';
+    buffer[5] = '\0';
+}
+
+// which moves a generator emits; every promotion counts as a capture so the two halves never overlap
+enum MoveGenType
+{
+    allMoves,
+    captureMoves,
+    quietMoves
+};
+
+// fixed capacity move list that lives on the stack, no position has more than 218 legal moves
+struct MoveList
+{
+    static constexpr int capacity = 256;
+
+    Move moves[capacity];
+    int count = 0;
+
+    void add(Move move) { moves[count++] = move; }
+    void clear() { count = 0; }
+    int size() const { return count; }
+
+    Move operator[](int index) const { return moves[index]; }
+    Move* begin() { return moves; }
+    Move* end() { return moves + count; }
+    const Move* begin() const { return moves; }
+    const Move* end() const { return moves + count; }
+};
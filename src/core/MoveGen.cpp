@@ -0,0 +1,360 @@
+#include "Board.h"
+
+constexpr U64 rank8 = 0x00000000000000FFULL;
+constexpr U64 rank7 = 0x000000000000FF00ULL;
+constexpr U64 rank2 = 0x00FF000000000000ULL;
+constexpr U64 rank1 = 0xFF00000000000000ULL;
+
+static inline void addMoves(MoveList& moveList, int from, U64 targets, U64 enemies)
+{
+    U64 captures = targets & enemies;
+    U64 quiets = targets & ~enemies;
+
+    while (captures)
+        moveList.add(encodeMove(from, popLSB(captures), captureFlag));
+    while (quiets)
+        moveList.add(encodeMove(from, popLSB(quiets), quietMove));
+}
+
+static inline U64 getTypeMask(MoveGenType type, U64 enemies, U64 empty)
+{
+    return type == captureMoves ? enemies : (type == quietMoves ? empty : ~0ULL);
+}
+
+static inline void addPromotions(MoveList& moveList, int from, int to, bool capture)
+{
+    int flags = capture ? knightPromotionCapture : knightPromotion;
+
+    // queen first, it is almost always the one worth searching
+    moveList.add(encodeMove(from, to, flags + 3));
+    moveList.add(encodeMove(from, to, flags + 2));
+    moveList.add(encodeMove(from, to, flags + 1));
+    moveList.add(encodeMove(from, to, flags));
+}
+
+U64 Board::getCheckers() const
+{
+    const int side = m_pos.side;
+    return attackersTo(getLSB(m_pos.pieces[whiteKing + side]), m_pos.occupied[both]) & m_pos.occupied[side ^ 1];
+}
+
+U64 Board::getPinnedPieces(int side) const
+{
+    return side == white ? getPinnedPieces<white>() : getPinnedPieces<black>();
+}
+
+template <Board::Color Us>
+U64 Board::getPinnedPieces() const
+{
+    constexpr Color Them = Us == white ? black : white;
+    const int king = getLSB(m_pos.pieces[whiteKing + Us]);
+    const U64 occ = m_pos.occupied[both];
+
+    // enemy sliders that would see the king on an empty board
+    U64 snipers = (getRookAttackBitboard(0ULL, king) & (m_pos.pieces[whiteRook + Them] | m_pos.pieces[whiteQueen + Them]))
+        | (getBishopAttackBitboard(0ULL, king) & (m_pos.pieces[whiteBishop + Them] | m_pos.pieces[whiteQueen + Them]));
+
+    U64 pinned = 0ULL;
+    while (snipers)
+    {
+        U64 blockers = betweenTable[king][popLSB(snipers)] & occ;
+        // exactly one piece in between, and it is ours
+        if (blockers && !(blockers & (blockers - 1)))
+            pinned |= blockers & m_pos.occupied[Us];
+    }
+
+    return pinned;
+}
+
+void Board::generatePseudoLegalMoves(MoveList& moveList, MoveGenType type) const
+{
+    if (m_pos.side == white)
+        generatePseudoLegalMoves<white>(moveList, type);
+    else
+        generatePseudoLegalMoves<black>(moveList, type);
+}
+
+void Board::generateLegalMoves(MoveList& moveList) const
+{
+    if (m_pos.side == white)
+        generateLegalMoves<white>(moveList);
+    else
+        generateLegalMoves<black>(moveList);
+}
+
+template <Board::Color Us>
+void Board::generatePseudoLegalMoves(MoveList& moveList, MoveGenType type) const
+{
+    constexpr Color Them = Us == white ? black : white;
+
+    generatePieceMoves<Us>(moveList, ~0ULL, 0ULL, false, type);
+
+    U64 kings = m_pos.pieces[whiteKing + Us];
+    if (kings)
+    {
+        int from = getLSB(kings);
+        addMoves(moveList, from, getKingAttackBitboard(from) & ~m_pos.occupied[Us] & getTypeMask(type, m_pos.occupied[Them], ~m_pos.occupied[both]), m_pos.occupied[Them]);
+    }
+
+    if (type != captureMoves)
+        generateCastlingMoves<Us>(moveList);
+}
+
+template <Board::Color Us>
+void Board::generateLegalMoves(MoveList& moveList) const
+{
+    constexpr Color Them = Us == white ? black : white;
+    const int king = getLSB(m_pos.pieces[whiteKing + Us]);
+    const U64 occ = m_pos.occupied[both];
+    const U64 enemies = m_pos.occupied[Them];
+    const U64 checkers = getAttackersOf<Them>(king, occ);
+
+    // king steps are tested with the king lifted off the board, so it can't hide behind itself from a slider
+    U64 targets = getKingAttackBitboard(king) & ~m_pos.occupied[Us];
+    U64 occWithoutKing = occ ^ (1ULL << king);
+    while (targets)
+    {
+        int to = popLSB(targets);
+        if (!getAttackersOf<Them>(to, occWithoutKing))
+            moveList.add(encodeMove(king, to, getBit(enemies, to) ? captureFlag : quietMove));
+    }
+
+    // in double check only the king can move
+    if (checkers & (checkers - 1))
+        return;
+
+    // in single check every other move has to capture the checker or block it
+    U64 checkMask = checkers ? (betweenTable[king][getLSB(checkers)] | checkers) : ~0ULL;
+    generatePieceMoves<Us>(moveList, checkMask, getPinnedPieces<Us>(), true, allMoves);
+
+    if (!checkers)
+        generateCastlingMoves<Us>(moveList);
+}
+
+// everything but the king; moves have to land on checkMask and pinned pieces stay on their pin line
+template <Board::Color Us>
+void Board::generatePieceMoves(MoveList& moveList, U64 checkMask, U64 pinned, bool legal, MoveGenType type) const
+{
+    constexpr Color Them = Us == white ? black : white;
+    const int king = pinned ? getLSB(m_pos.pieces[whiteKing + Us]) : 0;
+    const U64 occ = m_pos.occupied[both];
+    const U64 enemies = m_pos.occupied[Them];
+    const U64 targets = ~m_pos.occupied[Us] & checkMask & getTypeMask(type, enemies, ~occ);
+
+    generatePawnMoves<Us>(moveList, checkMask, pinned, legal, type);
+
+    // a pinned knight can never stay on the pin line
+    U64 pieces = m_pos.pieces[whiteKnight + Us] & ~pinned;
+    while (pieces)
+    {
+        int from = popLSB(pieces);
+        addMoves(moveList, from, getKnightAttackBitboard(from) & targets, enemies);
+    }
+
+    pieces = m_pos.pieces[whiteBishop + Us];
+    while (pieces)
+    {
+        int from = popLSB(pieces);
+        U64 pinMask = getBit(pinned, from) ? lineTable[king][from] : ~0ULL;
+        addMoves(moveList, from, getBishopAttackBitboard(occ, from) & targets & pinMask, enemies);
+    }
+
+    pieces = m_pos.pieces[whiteRook + Us];
+    while (pieces)
+    {
+        int from = popLSB(pieces);
+        U64 pinMask = getBit(pinned, from) ? lineTable[king][from] : ~0ULL;
+        addMoves(moveList, from, getRookAttackBitboard(occ, from) & targets & pinMask, enemies);
+    }
+
+    pieces = m_pos.pieces[whiteQueen + Us];
+    while (pieces)
+    {
+        int from = popLSB(pieces);
+        U64 pinMask = getBit(pinned, from) ? lineTable[king][from] : ~0ULL;
+        addMoves(moveList, from, getQueenAttackBitboard(occ, from) & targets & pinMask, enemies);
+    }
+}
+
+// adds the pushes and captures of a set of pawns that may only land on the allowed squares
+template <Board::Color Us>
+void Board::addPawnMoves(MoveList& moveList, U64 pawns, U64 allowed, MoveGenType type) const
+{
+    constexpr int forward = Us == white ? -8 : 8;
+    // square offsets from the target back to the capturing pawn
+    constexpr int westOffset = Us == white ? 9 : -7;
+    constexpr int eastOffset = Us == white ? 7 : -9;
+    constexpr U64 promotionRank = Us == white ? rank8 : rank1;
+    const U64 empty = ~m_pos.occupied[both];
+    const U64 enemies = m_pos.occupied[Us == white ? black : white];
+
+    U64 pushes = getPawnPushBitboard<Us>(pawns, empty) & allowed;
+
+    if (type != captureMoves)
+    {
+        U64 quietPushes = pushes & ~promotionRank;
+        while (quietPushes)
+        {
+            int to = popLSB(quietPushes);
+            moveList.add(encodeMove(to - forward, to, quietMove));
+        }
+
+        U64 doublePushes = getPawnDoublePushBitboard<Us>(pawns, empty) & allowed;
+        while (doublePushes)
+        {
+            int to = popLSB(doublePushes);
+            moveList.add(encodeMove(to - 2 * forward, to, doublePawnPush));
+        }
+    }
+
+    if (type == quietMoves)
+        return;
+
+    U64 promotions = pushes & promotionRank;
+    while (promotions)
+    {
+        int to = popLSB(promotions);
+        addPromotions(moveList, to - forward, to, false);
+    }
+
+    U64 westCaptures = getPawnWestCaptureBitboard<Us>(pawns) & enemies & allowed;
+    while (westCaptures)
+    {
+        int to = popLSB(westCaptures);
+        if (getBit(promotionRank, to))
+            addPromotions(moveList, to + westOffset, to, true);
+        else
+            moveList.add(encodeMove(to + westOffset, to, captureFlag));
+    }
+
+    U64 eastCaptures = getPawnEastCaptureBitboard<Us>(pawns) & enemies & allowed;
+    while (eastCaptures)
+    {
+        int to = popLSB(eastCaptures);
+        if (getBit(promotionRank, to))
+            addPromotions(moveList, to + eastOffset, to, true);
+        else
+            moveList.add(encodeMove(to + eastOffset, to, captureFlag));
+    }
+}
+
+template <Board::Color Us>
+void Board::generatePawnMoves(MoveList& moveList, U64 checkMask, U64 pinned, bool legal, MoveGenType type) const
+{
+    constexpr Color Them = Us == white ? black : white;
+    constexpr int forward = Us == white ? -8 : 8;
+    const int king = (pinned || legal) ? getLSB(m_pos.pieces[whiteKing + Us]) : 0;
+    const U64 pawns = m_pos.pieces[whitePawn + Us];
+
+    // unpinned pawns all share the check mask and move as one set
+    addPawnMoves<Us>(moveList, pawns & ~pinned, checkMask, type);
+
+    // every pinned pawn has a pin line of its own
+    U64 pinnedPawns = pawns & pinned;
+    while (pinnedPawns)
+    {
+        int from = popLSB(pinnedPawns);
+        addPawnMoves<Us>(moveList, 1ULL << from, checkMask & lineTable[king][from], type);
+    }
+
+    if (type == quietMoves || m_pos.enPassant == noSquare)
+        return;
+
+    // en passant removes two pawns from a line at once, so it is checked by replaying it on the occupancy
+    U64 captured = 1ULL << (m_pos.enPassant - forward);
+    U64 enPassantPawns = pawnAttackTable[Them][m_pos.enPassant] & pawns;
+    while (enPassantPawns)
+    {
+        int from = popLSB(enPassantPawns);
+        U64 occAfter = (m_pos.occupied[both] ^ (1ULL << from) ^ captured) | (1ULL << m_pos.enPassant);
+
+        if (!legal || !(getAttackersOf<Them>(king, occAfter) & ~captured))
+            moveList.add(encodeMove(from, m_pos.enPassant, enPassantCapture));
+    }
+}
+
+template <Board::Color Us>
+void Board::generateCastlingMoves(MoveList& moveList) const
+{
+    constexpr Color Them = Us == white ? black : white;
+    constexpr int kingSide = Us == white ? whiteKingSide : blackKingSide;
+    constexpr int queenSide = Us == white ? whiteQueenSide : blackQueenSide;
+    // e1 or e8, the other castling squares are fixed offsets from it
+    constexpr int king = Us == white ? e1 : e8;
+    const U64 occ = m_pos.occupied[both];
+
+    // the king may not castle out of, through or into check
+    if ((m_pos.castle & kingSide) && getBit(m_pos.pieces[whiteRook + Us], king + 3)
+        && !(occ & ((1ULL << (king + 1)) | (1ULL << (king + 2))))
+        && !isAnySquareAttacked<Them>((1ULL << king) | (1ULL << (king + 1)) | (1ULL << (king + 2))))
+        moveList.add(encodeMove(king, king + 2, kingCastle));
+
+    if ((m_pos.castle & queenSide) && getBit(m_pos.pieces[whiteRook + Us], king - 4)
+        && !(occ & ((1ULL << (king - 1)) | (1ULL << (king - 2)) | (1ULL << (king - 3))))
+        && !isAnySquareAttacked<Them>((1ULL << king) | (1ULL << (king - 1)) | (1ULL << (king - 2))))
+        moveList.add(encodeMove(king, king - 2, queenCastle));
+}
+
+// checks a move from the hash table or a killer slot against the position without generating anything
+bool Board::isPseudoLegal(Move move) const
+{
+    const int side = m_pos.side;
+    const int from = getMoveFrom(move);
+    const int to = getMoveTo(move);
+    const int flags = getMoveFlags(move);
+    const int piece = getPieceOn(from);
+
+    // flags 6 and 7 are unused
+    if (move == noMove || flags == 6 || flags == 7)
+        return false;
+    if (piece == noPiece || (piece & 1) != side || getBit(m_pos.occupied[side], to))
+        return false;
+
+    if (isCastlingMove(move))
+    {
+        MoveList castlingMoves;
+        if (side == white)
+            generateCastlingMoves<white>(castlingMoves);
+        else
+            generateCastlingMoves<black>(castlingMoves);
+        for (Move castlingMove : castlingMoves)
+        {
+            if (castlingMove == move)
+                return true;
+        }
+        return false;
+    }
+
+    const bool enemyOnTarget = getBit(m_pos.occupied[side ^ 1], to) != 0;
+
+    if (piece == whitePawn + side)
+    {
+        const int forward = side == white ? -8 : 8;
+        const U64 promotionRank = side == white ? rank8 : rank1;
+
+        if (isPromotionMove(move) != (getBit(promotionRank, to) != 0))
+            return false;
+
+        if (flags == enPassantCapture)
+            return to == m_pos.enPassant && getBit(getPawnAttackBitboard(side, from), to);
+
+        if (isCaptureMove(move))
+            return enemyOnTarget && getBit(getPawnAttackBitboard(side, from), to);
+
+        if (getBit(m_pos.occupied[both], to))
+            return false;
+
+        if (flags == doublePawnPush)
+            return getBit(side == white ? rank2 : rank7, from) && to == from + 2 * forward && !getBit(m_pos.occupied[both], from + forward);
+
+        return to == from + forward;
+    }
+
+    // everything else only moves or captures
+    if (flags != quietMove && flags != captureFlag)
+        return false;
+    if (isCaptureMove(move) != enemyOnTarget)
+        return false;
+
+    return getBit(getPieceAttackBitboard(piece, from, m_pos.occupied[both]), to) != 0;
+}
@@ -0,0 +1,183 @@
+#include "MovePicker.h"
+
+// victim values for MVV-LVA by piece type, the attacker type only breaks ties
+static constexpr int mvvValues[6] = { 100, 320, 330, 500, 900, 0 };
+
+// the quiescence picker never reaches the quiet moves their history is for
+static const ButterflyHistory noHistory = {};
+static const Move noKillers[2] = { noMove, noMove };
+
+MovePicker::MovePicker(const Board& board, Move ttMove, const Move (&killers)[2], Move counterMove, const ButterflyHistory& history,
+    const PieceToHistory* const (&continuations)[2])
+    : m_board(board)
+    , m_history(history)
+    , m_continuations{ continuations[0], continuations[1] }
+    , m_ttMove(board.isPseudoLegal(ttMove) ? ttMove : noMove)
+    , m_killers{ killers[0], killers[1] }
+    , m_counterMove(counterMove)
+    , m_stage(ttMoveStage)
+    , m_isQuiescence(false)
+    , m_current(0)
+    , m_badCurrent(0)
+{
+}
+
+MovePicker::MovePicker(const Board& board)
+    : m_board(board)
+    , m_history(noHistory)
+    , m_continuations{ nullptr, nullptr }
+    , m_ttMove(noMove)
+    , m_killers{ noKillers[0], noKillers[1] }
+    , m_counterMove(noMove)
+    , m_stage(generateCapturesStage)
+    , m_isQuiescence(true)
+    , m_current(0)
+    , m_badCurrent(0)
+{
+}
+
+void MovePicker::scoreCaptures()
+{
+    for (int i = 0; i < m_moves.size(); ++i)
+    {
+        Move move = m_moves[i];
+        int victim = getMoveFlags(move) == enPassantCapture ? Board::whitePawn : m_board.getPieceOn(getMoveTo(move));
+        int score = victim != Board::noPiece ? mvvValues[victim >> 1] * 8 : 0;
+
+        if (isPromotionMove(move))
+            score += mvvValues[getPromotionPiece(move, Board::white) >> 1] * 8;
+
+        m_scores[i] = score - (m_board.getPieceOn(getMoveFrom(move)) >> 1);
+    }
+}
+
+void MovePicker::scoreQuiets()
+{
+    const int side = m_board.getSide();
+
+    for (int i = 0; i < m_moves.size(); ++i)
+    {
+        Move move = m_moves[i];
+        int from = getMoveFrom(move);
+        int to = getMoveTo(move);
+        int piece = m_board.getPieceOn(from);
+
+        int score = m_history[side][from][to];
+        if (m_continuations[0])
+            score += (*m_continuations[0])[piece][to];
+        if (m_continuations[1])
+            score += (*m_continuations[1])[piece][to];
+        m_scores[i] = score;
+    }
+}
+
+bool MovePicker::isUsableQuiet(Move move) const
+{
+    return move != m_ttMove && !isCaptureMove(move) && !isPromotionMove(move) && m_board.isPseudoLegal(move);
+}
+
+Move MovePicker::pickBest()
+{
+    int best = m_current;
+    for (int i = m_current + 1; i < m_moves.size(); ++i)
+    {
+        if (m_scores[i] > m_scores[best])
+            best = i;
+    }
+
+    Move move = m_moves.moves[best];
+    m_moves.moves[best] = m_moves.moves[m_current];
+    m_scores[best] = m_scores[m_current];
+    m_current++;
+
+    return move;
+}
+
+Move MovePicker::next()
+{
+    switch (m_stage)
+    {
+        case ttMoveStage:
+            m_stage = generateCapturesStage;
+            if (m_ttMove != noMove)
+                return m_ttMove;
+            [[fallthrough]];
+
+        case generateCapturesStage:
+            m_board.generatePseudoLegalMoves(m_moves, captureMoves);
+            scoreCaptures();
+            m_current = 0;
+            m_stage = goodCapturesStage;
+            [[fallthrough]];
+
+        case goodCapturesStage:
+            while (m_current < m_moves.size())
+            {
+                Move move = pickBest();
+                if (move == m_ttMove)
+                    continue;
+
+                // losing captures wait until the quiet moves had their turn, quiescence drops them
+                if (m_board.see(move) < 0)
+                {
+                    if (!m_isQuiescence)
+                        m_badCaptures.add(move);
+                    continue;
+                }
+
+                return move;
+            }
+            if (m_isQuiescence)
+            {
+                m_stage = doneStage;
+                return noMove;
+            }
+            m_stage = firstKillerStage;
+            [[fallthrough]];
+
+        case firstKillerStage:
+            m_stage = secondKillerStage;
+            if (isUsableQuiet(m_killers[0]))
+                return m_killers[0];
+            [[fallthrough]];
+
+        case secondKillerStage:
+            m_stage = counterMoveStage;
+            if (m_killers[1] != m_killers[0] && isUsableQuiet(m_killers[1]))
+                return m_killers[1];
+            [[fallthrough]];
+
+        case counterMoveStage:
+            m_stage = generateQuietsStage;
+            if (!isKiller(m_counterMove) && isUsableQuiet(m_counterMove))
+                return m_counterMove;
+            [[fallthrough]];
+
+        case generateQuietsStage:
+            m_moves.clear();
+            m_board.generatePseudoLegalMoves(m_moves, quietMoves);
+            scoreQuiets();
+            m_current = 0;
+            m_stage = quietsStage;
+            [[fallthrough]];
+
+        case quietsStage:
+            while (m_current < m_moves.size())
+            {
+                Move move = pickBest();
+                if (move != m_ttMove && !isKiller(move) && move != m_counterMove)
+                    return move;
+            }
+            m_stage = badCapturesStage;
+            [[fallthrough]];
+
+        case badCapturesStage:
+            if (m_badCurrent < m_badCaptures.size())
+                return m_badCaptures[m_badCurrent++];
+            m_stage = doneStage;
+            [[fallthrough]];
+
+        default:
+            return noMove;
+    }
+}
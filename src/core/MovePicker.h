@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Board.h"
+
+// butterfly history, how well a quiet move of a side did in cutoffs, indexed by [side][from][to]
+typedef short ButterflyHistory[2][64][64];
+
+// how well a quiet move did by moving piece and target square, indexed by [piece][to]
+typedef short PieceToHistory[12][64];
+
+// continuation history, a PieceToHistory for every piece and target square of an earlier move; the same
+// table serves the move one ply back and the one two plies back
+typedef PieceToHistory ContinuationHistory[12][64];
+
+// history scores stay within +-historyLimit under the gravity update below, so they fit a short and the
+// tables stay small
+constexpr int historyLimit = 16384;
+
+// gravity update, moves entry towards the bonus by less the closer it already is to the bound on that side
+inline void updateHistory(short& entry, int bonus)
+{
+    int magnitude = bonus < 0 ? -bonus : bonus;
+    entry += (short)(bonus - entry * magnitude / historyLimit);
+}
+
+// hands out pseudo-legal moves one at a time in the order a search wants to try them,
+// generating and scoring each stage only once the previous one ran dry
+class MovePicker
+{
+public:
+    // continuations are the history tables following the moves one and two plies back, null where there is none
+    MovePicker(const Board& board, Move ttMove, const Move (&killers)[2], Move counterMove, const ButterflyHistory& history,
+        const PieceToHistory* const (&continuations)[2]);
+    // quiescence picker, only captures and promotions that don't lose material by SEE
+    explicit MovePicker(const Board& board);
+
+    // next move to search, noMove when all stages are exhausted
+    Move next();
+
+private:
+    enum Stage
+    {
+        ttMoveStage,
+        generateCapturesStage,
+        goodCapturesStage,
+        firstKillerStage,
+        secondKillerStage,
+        counterMoveStage,
+        generateQuietsStage,
+        quietsStage,
+        badCapturesStage,
+        doneStage
+    };
+
+    void scoreCaptures();
+    void scoreQuiets();
+    // moves the best scored move of the rest of the list to the front and returns it
+    Move pickBest();
+    bool isKiller(Move move) const { return move == m_killers[0] || move == m_killers[1]; }
+    // killers and countermoves come from other positions, only quiet moves that are pseudo-legal here are tried
+    bool isUsableQuiet(Move move) const;
+
+    const Board& m_board;
+    const ButterflyHistory& m_history;
+    const PieceToHistory* m_continuations[2];
+    Move m_ttMove;
+    Move m_killers[2];
+    Move m_counterMove;
+    int m_stage;
+    bool m_isQuiescence;
+
+    MoveList m_moves;
+    int m_scores[MoveList::capacity];
+    int m_current;
+
+    // captures that lose material by SEE, tried after the quiet moves
+    MoveList m_badCaptures;
+    int m_badCurrent;
+};
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <type_traits>
+
+#include "BitOps.h"
+
+// the complete game state as plain data, everything else a board needs
+// (attack tables, magics, masks) lives in static storage
+// being trivially copyable a position can be saved and restored with a memcpy,
+// and alignas(64) keeps it on exactly two cache lines
+struct alignas(64) Position
+{
+    U64 pieces[12];
+    U64 occupied[3];
+    unsigned char side;
+    signed char enPassant;
+    unsigned char castle;
+    unsigned short halfMove;
+    unsigned short fullMove;
+};
+
+static_assert(std::is_trivially_copyable<Position>::value, "Position must stay trivially copyable");
+static_assert(sizeof(Position) == 128, "Position must stay two cache lines");
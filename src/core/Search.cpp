@@ -0,0 +1,344 @@
+#include "Search.h"
+#include "Evaluate.h"
+
+#include <string.h>
+
+// first aspiration window half width in centipawns and the depth it starts at
+static const int aspirationDelta = 25;
+static const int aspirationDepth = 4;
+
+// a capture that can't lift the static score to alpha even with this much positional gain on top is skipped
+static const int deltaMargin = 200;
+
+// history bonus for a cutoff grows with the square of the depth up to this cap
+static const int maxHistoryBonus = 1600;
+
+static const PieceToHistory* const noContinuations[2] = { nullptr, nullptr };
+
+Search::Search()
+{
+    clear();
+}
+
+void Search::clear()
+{
+    memset(m_killers, 0, sizeof(m_killers));
+    memset(m_counterMoves, 0, sizeof(m_counterMoves));
+    memset(m_history, 0, sizeof(m_history));
+    memset(m_continuationHistory, 0, sizeof(m_continuationHistory));
+    m_previousPvLength = 0;
+    m_lastIteration = SearchIteration();
+    m_stats = SearchStats();
+}
+
+long long Search::getElapsedMilliseconds() const
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_startTime).count();
+}
+
+bool Search::shouldStop()
+{
+    if (m_stopped)
+        return true;
+    if (!m_canStop || (m_stats.nodes & 2047) != 0)
+        return false;
+
+    if ((m_limits.nodes && m_stats.nodes >= m_limits.nodes) || (m_limits.moveTime && !isPondering() && getElapsedMilliseconds() >= m_limits.moveTime)
+        || (m_limits.stopSignal && m_limits.stopSignal->load(std::memory_order_relaxed)))
+        m_stopped = true;
+
+    return m_stopped;
+}
+
+int Search::think(Board& board, const SearchLimits& limits, IterationCallback onIteration)
+{
+    m_limits = limits;
+    m_startTime = std::chrono::steady_clock::now();
+    m_canStop = false;
+    m_stopped = false;
+    m_previousPvLength = 0;
+    m_lastIteration = SearchIteration();
+    m_stats = SearchStats();
+
+    U64 previousIterationNodes = 0;
+    for (int depth = 1; depth <= limits.depth && depth < maxPly; ++depth)
+    {
+        U64 nodesBefore = m_stats.nodes;
+        int researches = 0;
+        int score = aspirationSearch(board, depth, m_lastIteration.score, &researches);
+
+        // an interrupted iteration can't be trusted, the previous one stands
+        if (m_stopped)
+            break;
+
+        SearchIteration& iteration = m_lastIteration;
+        iteration.depth = depth;
+        iteration.score = score;
+        iteration.nodes = m_stats.nodes;
+        iteration.qnodes = m_stats.qnodes;
+        iteration.cutoffs = m_stats.cutoffs;
+        iteration.firstMoveCutoffs = m_stats.firstMoveCutoffs;
+        iteration.milliseconds = getElapsedMilliseconds();
+        iteration.iterationNodes = m_stats.nodes - nodesBefore;
+        iteration.branchingFactor = previousIterationNodes ? (double)iteration.iterationNodes / previousIterationNodes : 0.0;
+        iteration.aspirationResearches = researches;
+        iteration.pvLength = m_pvLength[0];
+        memcpy(iteration.pv, m_pvTable[0], m_pvLength[0] * sizeof(Move));
+        previousIterationNodes = iteration.iterationNodes;
+
+        m_previousPvLength = m_pvLength[0];
+        memcpy(m_previousPv, m_pvTable[0], m_pvLength[0] * sizeof(Move));
+
+        if (onIteration)
+            onIteration(iteration);
+
+        // nothing to choose between, or a deeper iteration is unlikely to finish in the time left
+        if (iteration.pvLength == 0)
+            break;
+        if (limits.moveTime && !isPondering() && iteration.milliseconds * 2 >= limits.moveTime)
+            break;
+
+        m_canStop = true;
+    }
+
+    return m_lastIteration.score;
+}
+
+int Search::aspirationSearch(Board& board, int depth, int previousScore, int* researches)
+{
+    int delta = aspirationDelta;
+    int alpha = -infiniteScore;
+    int beta = infiniteScore;
+    if (depth >= aspirationDepth)
+    {
+        alpha = previousScore - delta > -infiniteScore ? previousScore - delta : -infiniteScore;
+        beta = previousScore + delta < infiniteScore ? previousScore + delta : infiniteScore;
+    }
+
+    while (true)
+    {
+        int score = alphaBeta(board, alpha, beta, depth, 0, true);
+        if (m_stopped)
+            return score;
+
+        // outside the window the score is only a bound, widen the failed side and search again
+        if (score <= alpha && alpha > -infiniteScore)
+            alpha = score - delta > -infiniteScore ? score - delta : -infiniteScore;
+        else if (score >= beta && beta < infiniteScore)
+            beta = score + delta < infiniteScore ? score + delta : infiniteScore;
+        else
+            return score;
+
+        delta *= 2;
+        (*researches)++;
+    }
+}
+
+int Search::alphaBeta(Board& board, int alpha, int beta, int depth, int ply, bool isOnPv)
+{
+    if (depth <= 0)
+        return quiescence(board, alpha, beta, ply);
+
+    m_pvLength[ply] = 0;
+    m_stats.nodes++;
+
+    if (shouldStop())
+        return 0;
+
+    // fifty move rule and repetitions, the root still has to pick a move
+    if (ply > 0 && (board.getHalfMoveClock() >= 100 || board.isRepetition()))
+        return 0;
+
+    if (ply >= maxPly - 1)
+        return evaluate(board);
+
+    const int side = board.getSide();
+    const bool inCheck = board.isInCheck(side);
+    const bool isPvNode = beta - alpha > 1;
+
+    // along the previous iteration's line its move comes first
+    Move pvMove = isOnPv && ply < m_previousPvLength ? m_previousPv[ply] : noMove;
+
+    // the moves one and two plies back pick the countermove and the continuation histories
+    Move counterMove = noMove;
+    const PieceToHistory* continuations[2] = { nullptr, nullptr };
+    if (ply >= 1)
+    {
+        const StackEntry& previous = m_stack[ply - 1];
+        counterMove = m_counterMoves[previous.piece][getMoveTo(previous.move)];
+        continuations[0] = &m_continuationHistory[previous.piece][getMoveTo(previous.move)];
+    }
+    if (ply >= 2)
+        continuations[1] = &m_continuationHistory[m_stack[ply - 2].piece][getMoveTo(m_stack[ply - 2].move)];
+
+    MovePicker picker(board, pvMove, m_killers[ply], counterMove, m_history, continuations);
+    int bestScore = -infiniteScore;
+    int legalCount = 0;
+    MoveList quietsTried;
+
+    for (Move move = picker.next(); move != noMove; move = picker.next())
+    {
+        m_stack[ply].move = move;
+        m_stack[ply].piece = board.getPieceOn(getMoveFrom(move));
+
+        // the picker hands out pseudo-legal moves, the ones leaving the king attacked are skipped here
+        board.makeMove(move);
+        if (board.isInCheck(side))
+        {
+            board.unmakeMove();
+            continue;
+        }
+        legalCount++;
+
+        // the first move gets the full window, the rest only have to prove they are no better and
+        // are searched again with the full window when they turn out to be
+        bool isChildOnPv = isOnPv && move == pvMove;
+        int score;
+        if (legalCount == 1)
+        {
+            score = -alphaBeta(board, -beta, -alpha, depth - 1, ply + 1, isChildOnPv);
+        }
+        else
+        {
+            score = -alphaBeta(board, -alpha - 1, -alpha, depth - 1, ply + 1, false);
+            if (score > alpha && score < beta && isPvNode)
+                score = -alphaBeta(board, -beta, -alpha, depth - 1, ply + 1, false);
+        }
+        board.unmakeMove();
+
+        if (m_stopped)
+            return 0;
+
+        if (score > bestScore)
+            bestScore = score;
+
+        if (score > alpha)
+        {
+            alpha = score;
+
+            // this move followed by the child's line
+            m_pvTable[ply][ply] = move;
+            memcpy(&m_pvTable[ply][ply + 1], &m_pvTable[ply + 1][ply + 1], m_pvLength[ply + 1] * sizeof(Move));
+            m_pvLength[ply] = m_pvLength[ply + 1] + 1;
+        }
+
+        // a quiet refutation feeds the killers, the countermove and the histories
+        const bool isQuiet = !isCaptureMove(move) && !isPromotionMove(move);
+        if (alpha >= beta)
+        {
+            m_stats.cutoffs++;
+            if (legalCount == 1)
+                m_stats.firstMoveCutoffs++;
+
+            if (isQuiet)
+                updateQuietHistories(board, move, quietsTried, depth, ply);
+            break;
+        }
+        if (isQuiet)
+            quietsTried.add(move);
+    }
+
+    // checkmate or stalemate, nearer mates score higher
+    if (legalCount == 0)
+        return inCheck ? -mateScore + ply : 0;
+
+    return bestScore;
+}
+
+int Search::quiescence(Board& board, int alpha, int beta, int ply)
+{
+    m_pvLength[ply] = 0;
+    m_stats.nodes++;
+    m_stats.qnodes++;
+
+    if (shouldStop())
+        return 0;
+
+    if (ply >= maxPly - 1)
+        return evaluate(board);
+
+    const int side = board.getSide();
+    const bool inCheck = board.isInCheck(side);
+
+    // stand pat, the side to move doesn't have to capture so the static score is a lower bound;
+    // in check there is no such choice and every evasion is searched
+    int standPat = -infiniteScore;
+    if (!inCheck)
+    {
+        standPat = evaluate(board);
+        if (standPat >= beta)
+            return standPat;
+        if (standPat > alpha)
+            alpha = standPat;
+    }
+
+    MovePicker picker = inCheck ? MovePicker(board, noMove, m_killers[ply], noMove, m_history, noContinuations) : MovePicker(board);
+    int bestScore = standPat;
+    int legalCount = 0;
+
+    for (Move move = picker.next(); move != noMove; move = picker.next())
+    {
+        // delta pruning, the captured piece and a margin still leave the score below alpha
+        if (!inCheck && !isPromotionMove(move))
+        {
+            int victim = getMoveFlags(move) == enPassantCapture ? Board::whitePawn : board.getPieceOn(getMoveTo(move));
+            if (standPat + pieceValues[victim >> 1] + deltaMargin <= alpha)
+                continue;
+        }
+
+        board.makeMove(move);
+        if (board.isInCheck(side))
+        {
+            board.unmakeMove();
+            continue;
+        }
+        legalCount++;
+
+        int score = -quiescence(board, -beta, -alpha, ply + 1);
+        board.unmakeMove();
+
+        if (m_stopped)
+            return 0;
+
+        if (score > bestScore)
+            bestScore = score;
+        if (score > alpha)
+            alpha = score;
+        if (alpha >= beta)
+            break;
+    }
+
+    if (inCheck && legalCount == 0)
+        return -mateScore + ply;
+
+    return bestScore;
+}
+
+void Search::updateQuietHistories(const Board& board, Move bestMove, const MoveList& quietsTried, int depth, int ply)
+{
+    if (m_killers[ply][0] != bestMove)
+    {
+        m_killers[ply][1] = m_killers[ply][0];
+        m_killers[ply][0] = bestMove;
+    }
+    if (ply >= 1)
+        m_counterMoves[m_stack[ply - 1].piece][getMoveTo(m_stack[ply - 1].move)] = bestMove;
+
+    int bonus = 32 * depth * depth < maxHistoryBonus ? 32 * depth * depth : maxHistoryBonus;
+    updateQuietHistory(board, bestMove, ply, bonus);
+    for (Move move : quietsTried)
+        updateQuietHistory(board, move, ply, -bonus);
+}
+
+void Search::updateQuietHistory(const Board& board, Move move, int ply, int bonus)
+{
+    const int from = getMoveFrom(move);
+    const int to = getMoveTo(move);
+    const int piece = board.getPieceOn(from);
+
+    updateHistory(m_history[board.getSide()][from][to], bonus);
+    if (ply >= 1)
+        updateHistory(m_continuationHistory[m_stack[ply - 1].piece][getMoveTo(m_stack[ply - 1].move)][piece][to], bonus);
+    if (ply >= 2)
+        updateHistory(m_continuationHistory[m_stack[ply - 2].piece][getMoveTo(m_stack[ply - 2].move)][piece][to], bonus);
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "Board.h"
+#include "MovePicker.h"
+
+#include <atomic>
+#include <chrono>
+
+// scores are centipawns for the side to move, mates count down from mateScore by the plies to mate
+constexpr int infiniteScore = 32000;
+constexpr int mateScore = 31000;
+constexpr int maxPly = 128;
+
+// when to stop, 0 leaves the time or node count unlimited
+struct SearchLimits
+{
+    int depth = maxPly - 1;
+    long long moveTime = 0;
+    U64 nodes = 0;
+    // set by another thread to end the search early, owned by the caller
+    const std::atomic<bool>* stopSignal = nullptr;
+    // while set the move time is not checked, clearing it starts applying it; the time spent pondering
+    // counts towards the move time
+    const std::atomic<bool>* ponderSignal = nullptr;
+};
+
+struct SearchStats
+{
+    // every node searched, the quiescence ones included
+    U64 nodes = 0;
+    U64 qnodes = 0;
+    // beta cutoffs in the main search and how many of them the first move searched produced
+    U64 cutoffs = 0;
+    U64 firstMoveCutoffs = 0;
+};
+
+// what one finished iteration of the iterative deepening found and what it cost
+struct SearchIteration
+{
+    int depth = 0;
+    int score = 0;
+    // nodes and milliseconds since the search started, the time to reach this depth
+    U64 nodes = 0;
+    U64 qnodes = 0;
+    U64 cutoffs = 0;
+    U64 firstMoveCutoffs = 0;
+    long long milliseconds = 0;
+    // nodes of this iteration alone and their ratio to the iteration before, the effective branching factor
+    U64 iterationNodes = 0;
+    double branchingFactor = 0.0;
+    // re-searches after the score fell outside the aspiration window
+    int aspirationResearches = 0;
+    int pvLength = 0;
+    Move pv[maxPly];
+};
+
+typedef void (*IterationCallback)(const SearchIteration& iteration);
+
+// one searcher with its own ordering tables, not shared between threads
+class Search
+{
+public:
+    Search();
+
+    // forgets killers, countermoves and histories so the next search doesn't depend on the ones before it
+    void clear();
+
+    // iterative deepening principal variation search until a limit is hit, calls onIteration after
+    // every finished depth and returns the score of the last one
+    int think(Board& board, const SearchLimits& limits, IterationCallback onIteration = nullptr);
+
+    // first move of the last finished iteration's principal variation, noMove without legal moves
+    Move getBestMove() const { return m_lastIteration.pvLength ? m_lastIteration.pv[0] : noMove; }
+    const SearchIteration& getLastIteration() const { return m_lastIteration; }
+    const SearchStats& getStats() const { return m_stats; }
+
+private:
+    // searches the root in a window around the previous score, widening it until the score falls inside
+    int aspirationSearch(Board& board, int depth, int previousScore, int* researches);
+    int alphaBeta(Board& board, int alpha, int beta, int depth, int ply, bool isOnPv);
+    // captures only below the horizon until the position is quiet, the static score stands when nothing beats it
+    int quiescence(Board& board, int alpha, int beta, int ply);
+    // rewards the quiet move that cut off and penalizes the quiet moves searched before it
+    void updateQuietHistories(const Board& board, Move bestMove, const MoveList& quietsTried, int depth, int ply);
+    void updateQuietHistory(const Board& board, Move move, int ply, int bonus);
+    // polls the clock and the stop signal every few thousand nodes, the first iteration always finishes
+    bool shouldStop();
+    long long getElapsedMilliseconds() const;
+    bool isPondering() const { return m_limits.ponderSignal && m_limits.ponderSignal->load(std::memory_order_relaxed); }
+
+    // piece and move made at every ply of the current line, the countermove and continuation lookups key on them
+    struct StackEntry
+    {
+        Move move;
+        int piece;
+    };
+    StackEntry m_stack[maxPly];
+
+    Move m_killers[maxPly][2];
+    // the quiet move that last refuted a move, indexed by that move's [piece][to]
+    Move m_counterMoves[12][64];
+    ButterflyHistory m_history;
+    ContinuationHistory m_continuationHistory;
+
+    // triangular table, row ply holds the best line found from that ply on
+    Move m_pvTable[maxPly][maxPly];
+    int m_pvLength[maxPly];
+    // the line of the previous iteration is searched first at the next depth
+    Move m_previousPv[maxPly];
+    int m_previousPvLength = 0;
+
+    SearchLimits m_limits;
+    std::chrono::steady_clock::time_point m_startTime;
+    bool m_canStop = false;
+    bool m_stopped = false;
+
+    SearchIteration m_lastIteration;
+    SearchStats m_stats;
+};
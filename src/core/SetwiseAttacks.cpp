@@ -0,0 +1,147 @@
+#include "SetwiseAttacks.h"
+
+#if defined(AVX2_FILL_AVAILABLE)
+#include <immintrin.h>
+#endif
+
+// squares a ray may enter after a one-square shift without wrapping around the board edge
+constexpr U64 notAfile = 0xFEFEFEFEFEFEFEFE;
+constexpr U64 notHfile = 0x7F7F7F7F7F7F7F7F;
+constexpr U64 notABfile = 0xFCFCFCFCFCFCFCFC;
+constexpr U64 notGHfile = 0x3F3F3F3F3F3F3F3F;
+
+// squares grow towards h1, so a left shift moves south or east and a right shift north or west:
+//   << 8 south, << 1 east, << 9 south east, << 7 south west
+//   >> 8 north, >> 1 west, >> 9 north west, >> 7 north east
+
+static inline U64 getAttacksShiftLeft(U64 gen, U64 empty, int shift, U64 wrapMask)
+{
+    U64 pro = empty & wrapMask;
+
+    // occluded fill, doubling the distance each step
+    gen |= pro & (gen << shift);
+    pro &= (pro << shift);
+    gen |= pro & (gen << (2 * shift));
+    pro &= (pro << (2 * shift));
+    gen |= pro & (gen << (4 * shift));
+
+    // one more step so the first blocker is attacked too
+    return (gen << shift) & wrapMask;
+}
+
+static inline U64 getAttacksShiftRight(U64 gen, U64 empty, int shift, U64 wrapMask)
+{
+    U64 pro = empty & wrapMask;
+
+    gen |= pro & (gen >> shift);
+    pro &= (pro >> shift);
+    gen |= pro & (gen >> (2 * shift));
+    pro &= (pro >> (2 * shift));
+    gen |= pro & (gen >> (4 * shift));
+
+    return (gen >> shift) & wrapMask;
+}
+
+U64 getPawnAttacksSetwise(int side, U64 pawns)
+{
+    // white pawns capture north, black pawns south
+    if (!side)
+        return ((pawns & notAfile) >> 9) | ((pawns & notHfile) >> 7);
+
+    return ((pawns & notAfile) << 7) | ((pawns & notHfile) << 9);
+}
+
+U64 getKnightAttacksSetwise(U64 knights)
+{
+    return ((knights & notAfile) >> 17) | ((knights & notAfile) << 15)
+        | ((knights & notABfile) >> 10) | ((knights & notABfile) << 6)
+        | ((knights & notGHfile) >> 6) | ((knights & notGHfile) << 10)
+        | ((knights & notHfile) >> 15) | ((knights & notHfile) << 17);
+}
+
+U64 getKingAttacksSetwise(U64 kings)
+{
+    // spread along the rank first, then copy that row one rank up and down
+    U64 row = kings | ((kings & notAfile) >> 1) | ((kings & notHfile) << 1);
+    return (row | (row >> 8) | (row << 8)) & ~kings;
+}
+
+U64 getRookAttacksSetwise(U64 rooks, U64 occ)
+{
+    U64 empty = ~occ;
+
+    return getAttacksShiftLeft(rooks, empty, 8, ~0ULL)
+        | getAttacksShiftLeft(rooks, empty, 1, notAfile)
+        | getAttacksShiftRight(rooks, empty, 8, ~0ULL)
+        | getAttacksShiftRight(rooks, empty, 1, notHfile);
+}
+
+U64 getBishopAttacksSetwise(U64 bishops, U64 occ)
+{
+    U64 empty = ~occ;
+
+    return getAttacksShiftLeft(bishops, empty, 9, notAfile)
+        | getAttacksShiftLeft(bishops, empty, 7, notHfile)
+        | getAttacksShiftRight(bishops, empty, 9, notHfile)
+        | getAttacksShiftRight(bishops, empty, 7, notAfile);
+}
+
+U64 getSliderAttacksSetwiseScalar(U64 rooksQueens, U64 bishopsQueens, U64 occ)
+{
+    return getRookAttacksSetwise(rooksQueens, occ) | getBishopAttacksSetwise(bishopsQueens, occ);
+}
+
+#if defined(AVX2_FILL_AVAILABLE)
+// lane i fills in the direction of the i-th shift, the left and right halves run the same steps
+AVX2_TARGET U64 getSliderAttacksSetwiseAvx2(U64 rooksQueens, U64 bishopsQueens, U64 occ)
+{
+    const __m256i shift1 = _mm256_setr_epi64x(8, 1, 9, 7);
+    const __m256i shift2 = _mm256_setr_epi64x(16, 2, 18, 14);
+    const __m256i shift4 = _mm256_setr_epi64x(32, 4, 36, 28);
+    const __m256i leftWrap = _mm256_setr_epi64x(-1LL, (long long)notAfile, (long long)notAfile, (long long)notHfile);
+    const __m256i rightWrap = _mm256_setr_epi64x(-1LL, (long long)notHfile, (long long)notHfile, (long long)notAfile);
+
+    const __m256i gen = _mm256_setr_epi64x((long long)rooksQueens, (long long)rooksQueens, (long long)bishopsQueens, (long long)bishopsQueens);
+    const __m256i empty = _mm256_set1_epi64x((long long)~occ);
+
+    // south, east, south east, south west
+    __m256i leftGen = gen;
+    __m256i leftPro = _mm256_and_si256(empty, leftWrap);
+    leftGen = _mm256_or_si256(leftGen, _mm256_and_si256(leftPro, _mm256_sllv_epi64(leftGen, shift1)));
+    leftPro = _mm256_and_si256(leftPro, _mm256_sllv_epi64(leftPro, shift1));
+    leftGen = _mm256_or_si256(leftGen, _mm256_and_si256(leftPro, _mm256_sllv_epi64(leftGen, shift2)));
+    leftPro = _mm256_and_si256(leftPro, _mm256_sllv_epi64(leftPro, shift2));
+    leftGen = _mm256_or_si256(leftGen, _mm256_and_si256(leftPro, _mm256_sllv_epi64(leftGen, shift4)));
+    __m256i attacks = _mm256_and_si256(_mm256_sllv_epi64(leftGen, shift1), leftWrap);
+
+    // north, west, north west, north east
+    __m256i rightGen = gen;
+    __m256i rightPro = _mm256_and_si256(empty, rightWrap);
+    rightGen = _mm256_or_si256(rightGen, _mm256_and_si256(rightPro, _mm256_srlv_epi64(rightGen, shift1)));
+    rightPro = _mm256_and_si256(rightPro, _mm256_srlv_epi64(rightPro, shift1));
+    rightGen = _mm256_or_si256(rightGen, _mm256_and_si256(rightPro, _mm256_srlv_epi64(rightGen, shift2)));
+    rightPro = _mm256_and_si256(rightPro, _mm256_srlv_epi64(rightPro, shift2));
+    rightGen = _mm256_or_si256(rightGen, _mm256_and_si256(rightPro, _mm256_srlv_epi64(rightGen, shift4)));
+    attacks = _mm256_or_si256(attacks, _mm256_and_si256(_mm256_srlv_epi64(rightGen, shift1), rightWrap));
+
+    // OR the four lanes together
+    __m128i half = _mm_or_si128(_mm256_castsi256_si128(attacks), _mm256_extracti128_si256(attacks, 1));
+    half = _mm_or_si128(half, _mm_unpackhi_epi64(half, half));
+    return (U64)_mm_cvtsi128_si64(half);
+}
+#else
+U64 getSliderAttacksSetwiseAvx2(U64 rooksQueens, U64 bishopsQueens, U64 occ)
+{
+    return getSliderAttacksSetwiseScalar(rooksQueens, bishopsQueens, occ);
+}
+#endif
+
+static const bool useAvx2Fill = cpuHasAvx2();
+
+U64 getSliderAttacksSetwise(U64 rooksQueens, U64 bishopsQueens, U64 occ)
+{
+    if (useAvx2Fill)
+        return getSliderAttacksSetwiseAvx2(rooksQueens, bishopsQueens, occ);
+
+    return getSliderAttacksSetwiseScalar(rooksQueens, bishopsQueens, occ);
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "AttackTables.h"
+
+// attacks of whole piece sets at once with Kogge-Stone occluded fills, no per-square lookups;
+// meant for mobility, king safety and threat maps where only the union of attacks matters
+
+U64 getPawnAttacksSetwise(int side, U64 pawns);
+U64 getKnightAttacksSetwise(U64 knights);
+U64 getKingAttacksSetwise(U64 kings);
+U64 getRookAttacksSetwise(U64 rooks, U64 occ);
+U64 getBishopAttacksSetwise(U64 bishops, U64 occ);
+
+// orthogonal rays from rooksQueens and diagonal rays from bishopsQueens, all eight directions
+// in one go; uses AVX2 lanes when the CPU has them
+U64 getSliderAttacksSetwise(U64 rooksQueens, U64 bishopsQueens, U64 occ);
+U64 getSliderAttacksSetwiseScalar(U64 rooksQueens, U64 bishopsQueens, U64 occ);
+U64 getSliderAttacksSetwiseAvx2(U64 rooksQueens, U64 bishopsQueens, U64 occ);
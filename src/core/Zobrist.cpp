@@ -0,0 +1,44 @@
+#include "Zobrist.h"
+
+// splitmix64, one step per key from a fixed seed
+static constexpr U64 nextRandom(U64& state)
+{
+    U64 z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static constexpr ZobristKeys generateZobristKeys()
+{
+    ZobristKeys keys = {};
+    U64 state = 0x2545F4914F6CDD1DULL;
+
+    for (int piece = 0; piece < 12; ++piece)
+    {
+        for (int square = 0; square < 64; ++square)
+            keys.pieces[piece][square] = nextRandom(state);
+    }
+
+    // no castling rights hashes to 0, the rest are combinations of the four single right keys
+    U64 castleRightKeys[4] = {};
+    for (int right = 0; right < 4; ++right)
+        castleRightKeys[right] = nextRandom(state);
+    for (int flags = 0; flags < 16; ++flags)
+    {
+        for (int right = 0; right < 4; ++right)
+        {
+            if (flags & (1 << right))
+                keys.castle[flags] ^= castleRightKeys[right];
+        }
+    }
+
+    for (int file = 0; file < 8; ++file)
+        keys.enPassant[file] = nextRandom(state);
+
+    keys.side = nextRandom(state);
+
+    return keys;
+}
+
+constexpr ZobristKeys zobristKeys = generateZobristKeys();
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "BitOps.h"
+
+// random keys XORed together into a position hash, generated at compile time so every
+// build and every thread hashes the same position to the same key
+struct ZobristKeys
+{
+    U64 pieces[12][64];
+    U64 castle[16];
+    // en passant keys by file
+    U64 enPassant[8];
+    U64 side;
+};
+
+extern const ZobristKeys zobristKeys;
+
+// 0 when there is no en passant square
+inline U64 getEnPassantKey(int square) { return square >= 0 ? zobristKeys.enPassant[square & 7] : 0ULL; }
@@ -1,5 +1,6 @@
 #include "GameLoop.h"
 #include "Board.h"
+#include "Fen.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
@@ -39,258 +40,6 @@ bool LoadTextureFromFile(const char* filename, GLuint* out_texture, int* out_wid
     return true;
 }
 
-bool parseFEN(Board* board, char *fen)
-{
-    // init piece placement
-    int i = 0;
-    for (int square = 0; square < 64; ++i)
-    {
-        // if current character is an alphabet, set pieces accordingly
-        if ((fen[i] >= 'a' && fen[i] <= 'z') || (fen[i] >= 'A' && fen[i] <= 'Z'))
-        {
-            switch (fen[i])
-            {
-                case 'p':
-                    // black rook
-                    board->setBlackPawns(square);
-                    board->setOccupiedBitboardSquare(board->black, square);
-                    board->setOccupiedBitboardSquare(board->both, square);
-                    square += 1;
-                    break;
-                case 'n':
-                    // black knight
-                    board->setBlackKnights(square);
-                    board->setOccupiedBitboardSquare(board->black, square);
-                    board->setOccupiedBitboardSquare(board->both, square);
-                    square += 1;
-                    break;
-                case 'b':
-                    // black bishop
-                    board->setBlackBishops(square);
-                    board->setOccupiedBitboardSquare(board->black, square);
-                    board->setOccupiedBitboardSquare(board->both, square);
-                    square += 1;
-                    break;
-                case 'r':
-                    // black rook
-                    board->setBlackRooks(square);
-                    board->setOccupiedBitboardSquare(board->black, square);
-                    board->setOccupiedBitboardSquare(board->both, square);
-                    square += 1;
-                    break;
-                case 'q':
-                    // black queen
-                    board->setBlackQueens(square);
-                    board->setOccupiedBitboardSquare(board->black, square);
-                    board->setOccupiedBitboardSquare(board->both, square);
-                    square += 1;
-                    break;
-                case 'k':
-                    // black king
-                    board->setBlackKing(square);
-                    board->setOccupiedBitboardSquare(board->black, square);
-                    board->setOccupiedBitboardSquare(board->both, square);
-                    square += 1;
-                    break;
-                case 'P':
-                    // white pawn
-                    board->setWhitePawns(square);
-                    board->setOccupiedBitboardSquare(board->white, square);
-                    board->setOccupiedBitboardSquare(board->both, square);
-                    square += 1;
-                    break;
-                case 'N':
-                    // white knight
-                    board->setWhiteKnights(square);
-                    board->setOccupiedBitboardSquare(board->white, square);
-                    board->setOccupiedBitboardSquare(board->both, square);
-                    square += 1;
-                    break;
-                case 'B':
-                    // white bishop
-                    board->setWhiteBishops(square);
-                    board->setOccupiedBitboardSquare(board->white, square);
-                    board->setOccupiedBitboardSquare(board->both, square);
-                    square += 1;
-                    break;
-                case 'R':
-                    // white rook
-                    board->setWhiteRooks(square);
-                    board->setOccupiedBitboardSquare(board->white, square);
-                    board->setOccupiedBitboardSquare(board->both, square);
-                    square += 1;
-                    break;
-                case 'Q':
-                    // white queen
-                    board->setWhiteQueens(square);
-                    board->setOccupiedBitboardSquare(board->white, square);
-                    board->setOccupiedBitboardSquare(board->both, square);
-                    square += 1;
-                    break;
-                case 'K':
-                    // white king
-                    board->setWhiteKing(square);
-                    board->setOccupiedBitboardSquare(board->white, square);
-                    board->setOccupiedBitboardSquare(board->both, square);
-                    square += 1;
-                    break;
-                default:
-                    printf("Wrong alphabet in the FEN string\n"); // DEBUG
-                    return false;
-            }
-        }
-        else if (fen[i] >= '0' && fen[i] <= '9')
-        {
-            int numEmpty = fen[i] - '0';
-            square += numEmpty;
-        }
-        else if (fen[i] == '/')
-        {
-            continue;
-        }
-        else
-        {
-            printf("WEIRD CHARACTER IN FEN STRING\n"); // DEBUG
-            return false;
-        }
-    }
-    board->updateEmptyBitboards();
-
-    // skip the first space
-    i += 1;
-
-    // init side
-    if (fen[i] == 'w')
-        board->setSide(board->white);
-    else if (fen[i] == 'b')
-        board->setSide(board->black);
-    else
-        return false;
-    i += 1;
-
-    // skip the second space
-    i += 1;
-
-    int castleFlags = board->none;
-    // init castling rights
-    while (fen[i] != ' ')
-    {
-        switch (fen[i])
-        {
-            case 'K':
-                castleFlags |= board->whiteKingSide;
-                break;
-            case 'Q':
-                castleFlags |= board->whiteQueenSide;
-                break;
-            case 'k':
-                castleFlags |= board->blackKingSide;
-                break;
-            case 'q':
-                castleFlags |= board->blackQueenSide;
-                break;
-            case '-':
-                break;
-            default:
-                return false;
-        }
-        i += 1;
-    }
-    board->setCastlingRights(castleFlags);
-
-    // skip the third space
-    i += 1;
-
-    int r = -1, f = -1;
-    bool first = true;
-
-    // init en passant target square
-    while (fen[i] != ' ')
-    {
-        if (fen[i] == '-')
-        {
-            board->setEnPassantSquare(board->noSquare);
-            i += 1;
-            break;
-        }
-        else
-        {
-            if (first)
-            {
-                f = fen[i] - 'a';
-                first = false;
-            }
-            else
-            {
-                r = fen[i] - '0';
-                r = 8 - r;
-                board->setEnPassantSquare(8 * r + f);
-            }
-            i += 1;
-        }
-    }
-
-    // skip the fourth space
-    i += 1;
-
-    // TODO: Halfmove clock and Fullmove counter
-
-    // init halfmove clock (up to 3 digit number)
-    int halfMove = 0;
-    int numDigit = 0;
-    int firstDigit = 0;
-    int secondDigit = 0;
-    int thirdDigit = 0;
-    while (fen[i] != ' ')
-    {
-        numDigit++;
-        if (numDigit == 1)
-            firstDigit = fen[i] - '0';
-        else if (numDigit == 2)
-            secondDigit = fen[i] - '0';
-        else if (numDigit == 3)
-            thirdDigit = fen[i] - '0';
-
-        i += 1;
-    }
-    if (numDigit == 1)
-        halfMove = firstDigit;
-    else if (numDigit == 2)
-        halfMove = firstDigit * 10 + secondDigit * 1;
-    else if (numDigit == 3)
-        halfMove = firstDigit * 100 + secondDigit * 10 + thirdDigit * 1;
-    printf("halfmove: %d\n", halfMove); // DEBUG
-    
-    // skip the fifth space
-    i += 1;
-
-    // init fullmove counter (up to 3 digit number)
-    int fullMove = 0;
-    numDigit = 0;
-    while (fen[i] != ' ' && fen[i] != '\0')
-    {
-        numDigit++;
-        if (numDigit == 1)
-            firstDigit = fen[i] - '0';
-        else if (numDigit == 2)
-            secondDigit = fen[i] - '0';
-        else if (numDigit == 3)
-            thirdDigit = fen[i] - '0';
-
-        i += 1;
-    }
-    if (numDigit == 1)
-        fullMove = firstDigit;
-    else if (numDigit == 2)
-        fullMove = firstDigit * 10 + secondDigit * 1;
-    else if (numDigit == 3)
-        fullMove = firstDigit * 100 + secondDigit * 10 + thirdDigit * 1;
-    printf("fullmove: %d\n\n", fullMove); // DEBUG
-
-
-    return true;
-}
-
 void runGameLoop(GLFWwindow* window)
 {
     // Our state
@@ -340,12 +89,22 @@ void runGameLoop(GLFWwindow* window)
     ret &= LoadTextureFromFile("../assets/blank.png", &blankTexture, &pieceImageWidth, &pieceImageHeight);
     IM_ASSERT(ret);
 
+    // textures in Board::PieceTypes order
+    const GLuint pieceTextures[12] = {
+        whitePawnImageTexture, blackPawnImageTexture,
+        whiteKnightImageTexture, blackKnightImageTexture,
+        whiteBishopImageTexture, blackBishopImageTexture,
+        whiteRookImageTexture, blackRookImageTexture,
+        whiteQueenImageTexture, blackQueenImageTexture,
+        whiteKingImageTexture, blackKingImageTexture
+    };
+
     // init game state
     Board board;
+    board.setAttackMapTracking(true);
     bool clickedOnPiece = false;
     int fromSquare = -1;
     //int toSquare = -1;
-    Board::PieceTypes pieceSelected = board.whitePawn;
     U64 possibleMoves = 0ULL;
     U64 possibleCaptures = 0ULL;
 
@@ -371,25 +130,27 @@ void runGameLoop(GLFWwindow* window)
         static char input[91] = "";
         if (ImGui::InputText("FEN string", input, 91, ImGuiInputTextFlags_EnterReturnsTrue))
         {
-            //char* fen = input;
-            printf("Entered: %s\n\n", input); // DEBUG
-
             // reset board
             board.resetBoard();
 
-            // parse FEN
+            // parse FEN, an invalid one leaves the board empty instead of half set up
             if (!parseFEN(&board, input))
-                printf("ERROR: INCORRECT FEN STRING\n"); // DEBUG
+                board.resetBoard();
 
             // clear input text field
             strcpy_s(input, "");
         }
 
         ImGui::SameLine();
-        if (ImGui::Button("DEBUG"))
+        if (ImGui::Button("UNDO") && board.getHistorySize() > 0)
         {
-            // DEBUG
-            printf("CURRENT EN PASSANT SQUARE %d\n", board.getEnPassantSquare());
+            board.unmakeMove();
+
+            // reset move state
+            clickedOnPiece = false;
+            possibleMoves = 0ULL;
+            possibleCaptures = 0ULL;
+            fromSquare = -1;
         }
 
         // show who's turn it is right now
@@ -436,1322 +197,75 @@ void runGameLoop(GLFWwindow* window)
             else if (fromSquare == square)
                 bg = selectedTile;
 
-            // clicked on an empty square
-            if (((board.getOccupiedBitboard(board.both) >> square) & 1ULL) == 0)
+            // draw the piece standing on the square
+            int piece = board.getPieceOn(square);
+            GLuint texture = piece != Board::noPiece ? pieceTextures[piece] : blankTexture;
+
+            if (ImGui::ImageButton((void*)(intptr_t)texture, BOARD_TILE, uv0, uv1, 0, bg, noTint))
             {
-                if (ImGui::ImageButton((void*)(intptr_t)blankTexture, BOARD_TILE, uv0, uv1, 0, bg, noTint))
+                // clicked on a piece of the side to move
+                if ((board.getOccupiedBitboard(board.getSide()) >> square) & 1ULL)
                 {
-                    // if no piece has been clicked
-                    if (!clickedOnPiece)
+                    // hasn't clicked on this piece yet
+                    if (!clickedOnPiece || fromSquare != square)
                     {
-                        printf("DO NOTHING\n"); // DEBUG
-                    }
-                    // if empty square is clicked after clicking on a piece first, validate the move
-                    else
-                    {
-                        // check if this is one of the possible moves
-                        if ((possibleMoves >> square) & 1ULL)
-                        {
-                            // move the piece to an empty square
-                            printf("MOVED A PIECE TO AN EMPTY SQUARE %d %d\n", pieceSelected, square); // DEBUG
-                            board.setPieceBitboard(pieceSelected, square);
-                            board.popPieceBitboard(pieceSelected, fromSquare);
-                            board.updateOccupiedBitboards();
-                            board.updateEmptyBitboards();
-
-                            // switch side
-                            board.flipSide();
-
-                            // set en passant square
-                            if (pieceSelected == board.whitePawn)
-                            {
-                                if (fromSquare - square == 16)
-                                {
-                                    printf("SETTING EN PASSANT SQUARE\n"); // DEBUG
-                                    board.setEnPassantSquare(square + 8);
-                                }
-                                // pawn promotion
-                                else
-                                {
-                                    if (fromSquare - square == 8 && square >= board.a8 && square <= board.h8)
-                                    {
-                                        printf("WHITE PAWN MOVE PROMOTION\n"); // DEBUG
-                                        board.popPieceBitboard(board.whitePawn, square);
-                                        board.setPieceBitboard(board.whiteQueen, square);
-                                        board.updateOccupiedBitboards();
-                                        board.updateEmptyBitboards();
-                                    }
-                                    board.setEnPassantSquare(board.noSquare);
-                                }
-                            }
-                            else if (pieceSelected == board.blackPawn)
-                            {
-                                if (square - fromSquare == 16)
-                                {
-                                    printf("SETTING EN PASSANT SQUARE\n"); // DEBUG
-                                    board.setEnPassantSquare(square - 8);
-                                }
-                                else
-                                {
-                                    if (square - fromSquare == 8 && square >= board.a1 && square <= board.h1)
-                                    {
-                                        printf("BLACK PAWN MOVE PROMOTION\n"); // DEBUG
-                                        board.popPieceBitboard(board.blackPawn, square);
-                                        board.setPieceBitboard(board.blackQueen, square);
-                                        board.updateOccupiedBitboards();
-                                        board.updateEmptyBitboards();
-                                    }
-                                    board.setEnPassantSquare(board.noSquare);
-                                }
-                            }
-                            // white castling
-                            else if (pieceSelected == board.whiteKing)
-                            {
-                                if (square == board.g1 && fromSquare == board.e1)
-                                {
-                                    if ((board.getCastlingRights() & board.whiteKingSide) && (board.getWhiteRooks() & (1ULL << board.h1)))
-                                    {
-                                        printf("WHITE KING SIDE CASTLE\n"); // DEBUG
-                                        board.popPieceBitboard(board.whiteRook, board.h1);
-                                        board.setPieceBitboard(board.whiteRook, board.f1);
-                                        board.updateOccupiedBitboards();
-                                        board.updateEmptyBitboards();
-                                        board.setEnPassantSquare(board.noSquare);
-                                    }
-                                }
-                                else if (square == board.c1 && fromSquare == board.e1)
-                                {
-                                    if ((board.getCastlingRights() & board.whiteQueenSide) && (board.getWhiteRooks() & (1ULL << board.a1)))
-                                    {
-                                        printf("WHITE QUEEN SIDE CASTLE\n"); // DEBUG
-                                        board.popPieceBitboard(board.whiteRook, board.a1);
-                                        board.setPieceBitboard(board.whiteRook, board.d1);
-                                        board.updateOccupiedBitboards();
-                                        board.updateEmptyBitboards();
-                                        board.setEnPassantSquare(board.noSquare);
-                                    }
-                                }
-                                // white king moved, white can't castle now
-                                board.setCastlingRights(board.getCastlingRights() & 12);
-                            }
-                            // black castling
-                            else if (pieceSelected == board.blackKing)
-                            {
-                                if (square == board.g8 && fromSquare == board.e8)
-                                {
-                                    if (board.getCastlingRights() & board.blackKingSide)
-                                    {
-                                        printf("BLACK KING SIDE CASTLE AVAILABLE\n"); // DEBUG
-                                        board.popPieceBitboard(board.blackRook, board.h8);
-                                        board.setPieceBitboard(board.blackRook, board.f8);
-                                        board.updateOccupiedBitboards();
-                                        board.updateEmptyBitboards();
-                                        board.setEnPassantSquare(board.noSquare);
-                                    }
-                                }
-                                else if (square == board.c8 && fromSquare == board.e8)
-                                {
-                                    if (board.getCastlingRights() & board.blackQueenSide)
-                                    {
-                                        printf("BLACK QUEEN SIDE CASTLE AVAILABLE\n"); // DEBUG
-                                        board.popPieceBitboard(board.blackRook, board.a8);
-                                        board.setPieceBitboard(board.blackRook, board.d8);
-                                        board.updateOccupiedBitboards();
-                                        board.updateEmptyBitboards();
-                                        board.setEnPassantSquare(board.noSquare);
-                                    }
-                                }
-                                // black king moved, black can't castle now
-                                board.setCastlingRights(board.getCastlingRights() & 3);
-                            }
-                            else if (pieceSelected == board.whiteRook)
-                            {
-                                // white rook moved, white can't castle now
-                                printf("WHITE ROOK MOVED TO CAPTURE A PIECE - WHITE CANNOT CASTLE NOW\n"); // DEBUG
-                                board.setCastlingRights(board.getCastlingRights() & 12);
-                                board.setEnPassantSquare(board.noSquare);
-                            }
-                            else if (pieceSelected == board.blackRook)
-                            {
-                                // black rook moved, black can't castle now
-                                printf("BLACK ROOK MOVED TO CAPTURE A PIECE - BLACK CANNOT CASTLE NOW\n"); // DEBUG
-                                board.setCastlingRights(board.getCastlingRights() & 3);
-                                board.setEnPassantSquare(board.noSquare);
-                            }
-                            else
-                            {
-                                board.setEnPassantSquare(board.noSquare);
-                            }
-                        }
-                        else
-                        {
-                            // check en passant
-                            if (square == board.getEnPassantSquare())
-                            {
-                                if (pieceSelected == board.whitePawn)
-                                {
-                                    if (fromSquare - square == 7 || fromSquare - square == 9)
-                                    {
-                                        printf("EN PASSANT\n"); // DEBUG
-                                        board.setPieceBitboard(pieceSelected, square);
-                                        board.popPieceBitboard(pieceSelected, fromSquare);
-                                        board.popPieceBitboard(board.blackPawn, square + 8);
-                                        board.updateOccupiedBitboards();
-                                        board.updateEmptyBitboards();
-
-                                        // switch side
-                                        board.flipSide();
-                                    }
-                                }
-                                else if (pieceSelected == board.blackPawn)
-                                {
-                                    if (square - fromSquare == 7 || square - fromSquare == 9)
-                                    {
-                                        printf("EN PASSANT\n"); // DEBUG
-                                        board.setPieceBitboard(pieceSelected, square);
-                                        board.popPieceBitboard(pieceSelected, fromSquare);
-                                        board.popPieceBitboard(board.whitePawn, square - 8);
-                                        board.updateOccupiedBitboards();
-                                        board.updateEmptyBitboards();
-
-                                        // switch side
-                                        board.flipSide();
-                                    }
-                                }
-                            }
-                            else
-                            {
-                                printf("INVALID MOVE\n"); // DEBUG
-                            }
-                        }
-
-                        // reset move state
-                        clickedOnPiece = false;
+                        fromSquare = square;
+                        // compute possible moves and captures from the legal moves of the piece
                         possibleMoves = 0ULL;
                         possibleCaptures = 0ULL;
-                        fromSquare = -1;
-                    }
-                }
-                ImGui::PopID();
-                continue;
-            }
-
-            // draw piece
-            if ((board.getWhitePawns() >> square) & 1ULL)
-            {
-                if (ImGui::ImageButton((void*)(intptr_t)whitePawnImageTexture, BOARD_TILE, uv0, uv1, 0, bg, noTint))
-                {
-                    // white turn clicking on a white pawn
-                    if (board.getSide() == board.white)
-                    {
-                        // hasn't clicked on a piece yet
-                        if (!clickedOnPiece || fromSquare != square)
-                        {
-                            fromSquare = square;
-                            pieceSelected = board.whitePawn;
-                            // compute possible moves and captures
-                            possibleMoves = board.getPawnMoveBitboard(board.white, square);
-                            possibleCaptures = pawnAttackTable[board.white][square] & board.getOccupiedBitboard(board.black);
-                            if (board.getEnPassantSquare() >= 0)
-                                possibleCaptures |= (pawnAttackTable[board.white][square] & (1ULL << board.getEnPassantSquare()));
-
-                            clickedOnPiece = true;
-                            // no possible moves or captures, reset the click state
-                            if ((possibleMoves | possibleCaptures) == 0ULL)
-                            {
-                                printf("NO POSSIBLE MOVES OR CAPTURES\n"); // DEBUG
-                                clickedOnPiece = !clickedOnPiece;
-                                fromSquare = -1;
-                            }
-                        }
-                        // can't capture your own piece
-                        else
-                        {
-                            printf("CANCEL - RECLICKING SAME PIECE\n"); // DEBUG
-                            possibleMoves = 0ULL;
-                            possibleCaptures = 0ULL;
-                            fromSquare = -1;
-                            clickedOnPiece = !clickedOnPiece;
-                        }
-                    }
-                    // black turn trying to capture a white pawn
-                    else
-                    {
-                        if (clickedOnPiece)
-                        {
-                            // a piece is trying to capture white pawn
-                            // check if it is a valid capture
-                            if ((possibleCaptures >> square) & 1ULL)
-                            {
-                                printf("CAPTURING WHITE PAWN\n"); // DEBUG
-                                board.popPieceBitboard(board.whitePawn, square);
-                                board.popPieceBitboard(pieceSelected, fromSquare);
-                                board.setPieceBitboard(pieceSelected, square);
-                                board.updateOccupiedBitboards();
-                                board.updateEmptyBitboards();
-
-                                if (pieceSelected == board.blackKing || pieceSelected == board.blackRook)
-                                {
-                                    // black king moved, black can't castle now
-                                    printf("BLACK KING MOVED TO CAPTURE A PIECE - BLACK CANNOT CASTLE NOW\n"); // DEBUG
-                                    board.setCastlingRights(board.getCastlingRights() & 3);
-                                }
-
-                                // switch side
-                                board.flipSide();
-                                fromSquare = -1;
-                            }
-                            else
-                            {
-                                printf("CANCEL - NOT A VALID CAPTURE FOR BLACK\n"); // DEBUG
-                            }
-
-                            // reset move state
-                            clickedOnPiece = false;
-                            possibleMoves = 0ULL;
-                            possibleCaptures = 0ULL;
-                            fromSquare = -1;
-                        }
-                        else
-                        {
-                            printf("DO NOTHING\n"); // DEBUG
-                        }
-                    }
-                }
-            }
-            else if ((board.getBlackPawns() >> square) & 1ULL)
-            {
-                if (ImGui::ImageButton((void*)(intptr_t)blackPawnImageTexture, BOARD_TILE, uv0, uv1, 0, bg, noTint))
-                {
-                    // black turn clicking on a black pawn
-                    if (board.getSide() == board.black)
-                    {
-                        // hasn't clicked on a piece yet
-                        if (!clickedOnPiece || fromSquare != square)
-                        {
-                            fromSquare = square;
-                            pieceSelected = board.blackPawn;
-                            // compute possible moves or captures
-                            possibleMoves = board.getPawnMoveBitboard(board.black, square);
-                            possibleCaptures = pawnAttackTable[board.black][square] & board.getOccupiedBitboard(board.white);
-                            if (board.getEnPassantSquare() >= 0)
-                                possibleCaptures |= (pawnAttackTable[board.black][square] & (1ULL << board.getEnPassantSquare()));
-
-                            clickedOnPiece = true;
-                            // no possible moves or captures, reset the click state
-                            if ((possibleMoves | possibleCaptures) == 0ULL)
-                            {
-                                printf("NO POSSIBLE MOVES OR CAPTURES\n"); // DEBUG
-                                clickedOnPiece = !clickedOnPiece;
-                                fromSquare = -1;
-                            }
-                        }
-                        // can't capture your own piece
-                        else
-                        {
-                            printf("CANCEL - RECLICKING SAME PIECE\n"); // DEBUG
-                            possibleMoves = 0ULL;
-                            possibleCaptures = 0ULL;
-                            fromSquare = -1;
-                            clickedOnPiece = !clickedOnPiece;
-                        }
-                    }
-                    // white turn clicking on a black pawn
-                    else
-                    {
-                        if (clickedOnPiece)
-                        {
-                            // a piece is trying to capture black pawn
-                            // check if it is a valid capture
-                            if ((possibleCaptures >> square) & 1ULL)
-                            {
-                                printf("CAPTURING BLACK PAWN\n"); // DEBUG
-                                board.popPieceBitboard(board.blackPawn, square);
-                                board.popPieceBitboard(pieceSelected, fromSquare);
-                                board.setPieceBitboard(pieceSelected, square);
-                                board.updateOccupiedBitboards();
-                                board.updateEmptyBitboards();
-
-                                if (pieceSelected == board.whiteKing || pieceSelected == board.whiteRook)
-                                {
-                                    // white king moved, white can't castle now
-                                    printf("WHITE KING MOVED TO CAPTURE A PIECE - WHITE CANNOT CASTLE NOW\n"); // DEBUG
-                                    board.setCastlingRights(board.getCastlingRights() & 12);
-                                }
-
-                                // switch side
-                                board.flipSide();
-                                fromSquare = -1;
-                            }
-                            else
-                            {
-                                printf("CANCEL - NOT A VALID CAPTURE FOR WHITE\n"); // DEBUG
-                            }
-
-                            // reset move state
-                            clickedOnPiece = false;
-                            possibleMoves = 0ULL;
-                            possibleCaptures = 0ULL;
-                            fromSquare = -1;
-                        }
-                        else
-                        {
-                            printf("DO NOTHING\n"); // DEBUG
-                        }
-                    }
-                }
-            }
-            else if ((board.getWhiteKnights() >> square) & 1ULL)
-            {
-                if (ImGui::ImageButton((void*)(intptr_t)whiteKnightImageTexture, BOARD_TILE, uv0, uv1, 0, bg, noTint))
-                {
-                    // white turn clicking on a white knight
-                    if (board.getSide() == board.white)
-                    {
-                        // hasn't clicked on a piece yet
-                        if (!clickedOnPiece || fromSquare != square)
-                        {
-                            fromSquare = square;
-                            pieceSelected = board.whiteKnight;
-                            // compute possible moves and captures
-                            possibleMoves = knightAttackTable[square] & board.getEmptyBitboard();
-                            possibleCaptures = knightAttackTable[square] & board.getOccupiedBitboard(board.black);
-
-                            clickedOnPiece = true;
-                            // no possible moves or captures, reset the click state
-                            if ((possibleMoves | possibleCaptures) == 0ULL)
-                            {
-                                printf("NO POSSIBLE MOVES OR CAPTURES\n"); // DEBUG
-                                clickedOnPiece = !clickedOnPiece;
-                                fromSquare = -1;
-                            }
-                        }
-                        // can't capture your own piece
-                        else
-                        {
-                            printf("CANCEL - RECLICKING SAME PIECE\n"); // DEBUG
-                            possibleMoves = 0ULL;
-                            possibleCaptures = 0ULL;
-                            fromSquare = -1;
-                            clickedOnPiece = !clickedOnPiece;
-                        }
-                        
-                    }
-                    // black turn trying to capture a white knight
-                    else
-                    {
-                        if (clickedOnPiece)
-                        {
-                            // a piece is trying to capture white knight
-                            // check if it is a valid capture
-                            if ((possibleCaptures >> square) & 1ULL)
-                            {
-                                board.popPieceBitboard(board.whiteKnight, square);
-                                board.popPieceBitboard(pieceSelected, fromSquare);
-                                if (pieceSelected == board.blackPawn && (square - fromSquare == 7 || square - fromSquare == 9))
-                                {
-                                    printf("CAPTURING WHITE KNIGHT AND PROMOTING BLACK PAWN\n"); // DEBUG
-                                    board.setPieceBitboard(board.blackQueen, square);
-                                }
-                                else
-                                {
-                                    printf("CAPTURING WHITE KNIGHT\n"); // DEBUG
-                                    board.setPieceBitboard(pieceSelected, square);
-                                }
-                                board.updateOccupiedBitboards();
-                                board.updateEmptyBitboards();
-
-                                if (pieceSelected == board.blackKing || pieceSelected == board.blackRook)
-                                {
-                                    // black king moved, black can't castle now
-                                    printf("BLACK KING MOVED TO CAPTURE A PIECE - BLACK CANNOT CASTLE NOW\n"); // DEBUG
-                                    board.setCastlingRights(board.getCastlingRights() & 3);
-                                }
-
-                                // switch side
-                                board.flipSide();
-                                fromSquare = -1;
-                            }
-                            else
-                            {
-                                printf("CANCEL - NOT A VALID CAPTURE FOR BLACK\n"); // DEBUG
-                            }
-
-                            // reset move state
-                            clickedOnPiece = false;
-                            possibleMoves = 0ULL;
-                            possibleCaptures = 0ULL;
-                            fromSquare = -1;
-                        }
-                        else
-                        {
-                            printf("DO NOTHING\n"); // DEBUG
-                        }
-                    }
-                }
-            }
-            else if ((board.getBlackKnights() >> square) & 1ULL)
-            {
-                if (ImGui::ImageButton((void*)(intptr_t)blackKnightImageTexture, BOARD_TILE, uv0, uv1, 0, bg, noTint))
-                {
-                    // black turn clicking on a black knight
-                    if (board.getSide() == board.black)
-                    {
-                        // hasn't clicked on a piece yet
-                        if (!clickedOnPiece || fromSquare != square)
-                        {
-                            fromSquare = square;
-                            pieceSelected = board.blackKnight;
-                            // compute possible moves and captures
-                            possibleMoves = knightAttackTable[square] & board.getEmptyBitboard();
-                            possibleCaptures = knightAttackTable[square] & board.getOccupiedBitboard(board.white);
-
-                            clickedOnPiece = true;
-                            // no possible moves or captures, reset the click state
-                            if ((possibleMoves | possibleCaptures) == 0ULL)
-                            {
-                                printf("NO POSSIBLE MOVES OR CAPTURES\n"); // DEBUG
-                                clickedOnPiece = !clickedOnPiece;
-                                fromSquare = -1;
-                            }
-                        }
-                        // can't capture your own piece
-                        else
-                        {
-                            printf("CANCEL - RECLICKING SAME PIECE\n"); // DEBUG
-                            possibleMoves = 0ULL;
-                            possibleCaptures = 0ULL;
-                            fromSquare = -1;
-                            clickedOnPiece = !clickedOnPiece;
-                        }
-                    }
-                    // white turn trying to capture a black knight
-                    else
-                    {
-                        if (clickedOnPiece)
-                        {
-                            // a piece is trying to capture black knight
-                            // check if it is a valid capture
-                            if ((possibleCaptures >> square) & 1ULL)
-                            {
-                                board.popPieceBitboard(board.blackKnight, square);
-                                board.popPieceBitboard(pieceSelected, fromSquare);
-                                if (pieceSelected == board.whitePawn && (fromSquare - square == 7 || fromSquare - square == 9))
-                                {
-                                    printf("CAPTURING BLACK KNIGHT AND PROMOTING WHITE PAWN\n"); // DEBUG
-                                    board.setPieceBitboard(board.whiteQueen, square);
-                                }
-                                else
-                                {
-                                    printf("CAPTURING BLACK KNIGHT\n"); // DEBUG
-                                    board.setPieceBitboard(pieceSelected, square);
-                                }
-                                board.updateOccupiedBitboards();
-                                board.updateEmptyBitboards();
-
-                                if (pieceSelected == board.whiteKing || pieceSelected == board.whiteRook)
-                                {
-                                    // white king moved, white can't castle now
-                                    printf("WHITE KING MOVED TO CAPTURE A PIECE - WHITE CANNOT CASTLE NOW\n"); // DEBUG
-                                    board.setCastlingRights(board.getCastlingRights() & 12);
-                                }
-
-                                // switch side
-                                board.flipSide();
-                                fromSquare = -1;
-                            }
-                            else
-                            {
-                                printf("CANCEL - NOT A VALID CAPTURE FOR WHITE\n"); // DEBUG
-                            }
-
-                            // reset move state
-                            clickedOnPiece = false;
-                            possibleMoves = 0ULL;
-                            possibleCaptures = 0ULL;
-                            fromSquare = -1;
-                        }
-                        else
-                        {
-                            printf("DO NOTHING\n"); // DEBUG
-                        }
-                    }
-                }
-            }
-            else if ((board.getWhiteBishops() >> square) & 1ULL)
-            {
-                if (ImGui::ImageButton((void*)(intptr_t)whiteBishopImageTexture, BOARD_TILE, uv0, uv1, 0, bg, noTint))
-                {
-                    // white turn clicking on a white bishop
-                    if (board.getSide() == board.white)
-                    {
-                        // hasn't clicked on a piece yet
-                        if (!clickedOnPiece || fromSquare != square)
-                        {
-                            fromSquare = square;
-                            pieceSelected = board.whiteBishop;
-                            // compute possible moves and captures
-                            U64 bishopMoves = board.getBishopAttackBitboard(board.getOccupiedBitboard(board.both), square);
-                            possibleMoves = bishopMoves & board.getEmptyBitboard();
-                            possibleCaptures = bishopMoves & board.getOccupiedBitboard(board.black);
-
-                            clickedOnPiece = true;
-                            // no possible moves or captures, reset the click state
-                            if ((possibleMoves | possibleCaptures) == 0ULL)
-                            {
-                                printf("NO POSSIBLE MOVES OR CAPTURES\n"); // DEBUG
-                                clickedOnPiece = !clickedOnPiece;
-                                fromSquare = -1;
-                            }
-                        }
-                        // can't capture your own piece
-                        else
-                        {
-                            printf("CANCEL - RECLICKING SAME PIECE\n"); // DEBUG
-                            possibleMoves = 0ULL;
-                            possibleCaptures = 0ULL;
-                            fromSquare = -1;
-                            clickedOnPiece = !clickedOnPiece;
-                        }
-                    }
-                    // black turn trying to capture a white bishop
-                    else
-                    {
-                        if (clickedOnPiece)
-                        {
-                            // a piece is trying to capture white bishop
-                            // check if it is a valid capture
-                            if ((possibleCaptures >> square) & 1ULL)
-                            {
-                                board.popPieceBitboard(board.whiteBishop, square);
-                                board.popPieceBitboard(pieceSelected, fromSquare);
-                                if (pieceSelected == board.blackPawn && (square - fromSquare == 7 || square - fromSquare == 9))
-                                {
-                                    printf("CAPTURING WHITE BISHOP AND PROMOTING BLACK PAWN\n"); // DEBUG
-                                    board.setPieceBitboard(board.blackQueen, square);
-                                }
-                                else
-                                {
-                                    printf("CAPTURING WHITE BISHOP\n"); // DEBUG
-                                    board.setPieceBitboard(pieceSelected, square);
-                                }
-                                board.updateOccupiedBitboards();
-                                board.updateEmptyBitboards();
-
-                                if (pieceSelected == board.blackKing || pieceSelected == board.blackRook)
-                                {
-                                    // black king moved, black can't castle now
-                                    printf("BLACK KING MOVED TO CAPTURE A PIECE - BLACK CANNOT CASTLE NOW\n"); // DEBUG
-                                    board.setCastlingRights(board.getCastlingRights() & 3);
-                                }
-
-                                // switch side
-                                board.flipSide();
-                                fromSquare = -1;
-                            }
-                            else
-                            {
-                                printf("CANCEL - NOT A VALID CAPTURE FOR BLACK\n"); // DEBUG
-                            }
-
-                            // reset move state
-                            clickedOnPiece = false;
-                            possibleMoves = 0ULL;
-                            possibleCaptures = 0ULL;
-                            fromSquare = -1;
-                        }
-                        else
-                        {
-                            printf("DO NOTHING\n"); // DEBUG
-                        }
-                    }
-                }
-            }
-            else if ((board.getBlackBishops() >> square) & 1ULL)
-            {
-                if (ImGui::ImageButton((void*)(intptr_t)blackBishopImageTexture, BOARD_TILE, uv0, uv1, 0, bg, noTint))
-                {
-                    // black turn clicking on a black bishop
-                    if (board.getSide() == board.black)
-                    {
-                        // hasn't clicked on a piece yet
-                        if (!clickedOnPiece || fromSquare != square)
-                        {
-                            fromSquare = square;
-                            pieceSelected = board.blackBishop;
-                            // compute possible moves and captures
-                            U64 bishopMoves = board.getBishopAttackBitboard(board.getOccupiedBitboard(board.both), square);
-                            possibleMoves = bishopMoves & board.getEmptyBitboard();
-                            possibleCaptures = bishopMoves & board.getOccupiedBitboard(board.white);
-
-                            clickedOnPiece = true;
-                            // no possible moves or captures, reset the click state
-                            if ((possibleMoves | possibleCaptures) == 0ULL)
-                            {
-                                printf("NO POSSIBLE MOVES OR CAPTURES\n"); // DEBUG
-                                clickedOnPiece = !clickedOnPiece;
-                                fromSquare = -1;
-                            }
-                        }
-                        // can't capture your own piece
-                        else
-                        {
-                            printf("CANCEL - RECLICKING SAME PIECE\n"); // DEBUG
-                            possibleMoves = 0ULL;
-                            possibleCaptures = 0ULL;
-                            fromSquare = -1;
-                            clickedOnPiece = !clickedOnPiece;
-                        }
-                    }
-                    // white turn trying to capture a black bishop
-                    else
-                    {
-                        if (clickedOnPiece)
-                        {
-                            // a piece is trying to capture black bishop
-                            // check if it is a valid capture
-                            if ((possibleCaptures >> square) & 1ULL)
-                            {
-                                board.popPieceBitboard(board.blackBishop, square);
-                                board.popPieceBitboard(pieceSelected, fromSquare);
-                                if (pieceSelected == board.whitePawn && (fromSquare - square == 7 || fromSquare - square == 9))
-                                {
-                                    printf("CAPTURING BLACK BISHOP AND PROMOTING WHITE PAWN\n"); // DEBUG
-                                    board.setPieceBitboard(board.whiteQueen, square);
-                                }
-                                else
-                                {
-                                    printf("CAPTURING BLACK BISHOP\n"); // DEBUG
-                                    board.setPieceBitboard(pieceSelected, square);
-                                }
-                                board.updateOccupiedBitboards();
-                                board.updateEmptyBitboards();
-
-                                if (pieceSelected == board.whiteKing || pieceSelected == board.whiteRook)
-                                {
-                                    // white king moved, white can't castle now
-                                    printf("WHITE KING MOVED TO CAPTURE A PIECE - WHITE CANNOT CASTLE NOW\n"); // DEBUG
-                                    board.setCastlingRights(board.getCastlingRights() & 12);
-                                }
-
-                                // switch side
-                                board.flipSide();
-                                fromSquare = -1;
-                            }
-                            else
-                            {
-                                printf("CANCEL - NOT A VALID CAPTURE FOR WHITE\n"); // DEBUG
-                            }
-
-                            // reset move state
-                            clickedOnPiece = false;
-                            possibleMoves = 0ULL;
-                            possibleCaptures = 0ULL;
-                            fromSquare = -1;
-                        }
-                        else
-                        {
-                            printf("DO NOTHING\n"); // DEBUG
-                        }
-                    }
-                }
-            }
-            else if ((board.getWhiteRooks() >> square) & 1ULL)
-            {
-                if (ImGui::ImageButton((void*)(intptr_t)whiteRookImageTexture, BOARD_TILE, uv0, uv1, 0, bg, noTint))
-                {
-                    // white turn clicking on a white rook
-                    if (board.getSide() == board.white)
-                    {
-                        // hasn't clicked on a piece yet
-                        if (!clickedOnPiece || fromSquare != square)
-                        {
-                            fromSquare = square;
-                            pieceSelected = board.whiteRook;
-                            // compute possible moves and captures
-                            U64 rookMoves = board.getRookAttackBitboard(board.getOccupiedBitboard(board.both), square);
-                            possibleMoves = rookMoves & board.getEmptyBitboard();
-                            possibleCaptures = rookMoves & board.getOccupiedBitboard(board.black);
-
-                            clickedOnPiece = true;
-                            // no possible moves or captures, reset the click state
-                            if ((possibleMoves | possibleCaptures) == 0ULL)
-                            {
-                                printf("NO POSSIBLE MOVES OR CAPTURES\n"); // DEBUG
-                                clickedOnPiece = !clickedOnPiece;
-                                fromSquare = -1;
-                            }
-                        }
-                        // can't capture your own piece
-                        else
-                        {
-                            printf("CANCEL - RECLICKING SAME PIECE\n"); // DEBUG
-                            possibleMoves = 0ULL;
-                            possibleCaptures = 0ULL;
-                            fromSquare = -1;
-                            clickedOnPiece = !clickedOnPiece;
-                        }
-                    }
-                    // black turn trying to capture a white rook
-                    else
-                    {
-                        if (clickedOnPiece)
-                        {
-                            // a piece is trying to capture white rook
-                            // check if it is a valid capture
-                            if ((possibleCaptures >> square) & 1ULL)
-                            {
-                                board.popPieceBitboard(board.whiteRook, square);
-                                board.popPieceBitboard(pieceSelected, fromSquare);
-                                if (pieceSelected == board.blackPawn && (square - fromSquare == 7 || square - fromSquare == 9))
-                                {
-                                    printf("CAPTURING WHITE ROOK AND PROMOTING BLACK PAWN\n"); // DEBUG
-                                    board.setPieceBitboard(board.blackQueen, square);
-                                }
-                                else
-                                {
-                                    printf("CAPTURING WHITE ROOK\n"); // DEBUG
-                                    board.setPieceBitboard(pieceSelected, square);
-                                }
-                                board.updateOccupiedBitboards();
-                                board.updateEmptyBitboards();
-
-                                if (pieceSelected == board.blackKing || pieceSelected == board.blackRook)
-                                {
-                                    // black king moved, black can't castle now
-                                    printf("BLACK KING MOVED TO CAPTURE A PIECE - BLACK CANNOT CASTLE NOW\n"); // DEBUG
-                                    board.setCastlingRights(board.getCastlingRights() & 3);
-                                }
-
-                                // switch side
-                                board.flipSide();
-                                fromSquare = -1;
-                            }
-                            else
-                            {
-                                printf("CANCEL - NOT A VALID CAPTURE FOR BLACK\n"); // DEBUG
-                            }
-
-                            // reset move state
-                            clickedOnPiece = false;
-                            possibleMoves = 0ULL;
-                            possibleCaptures = 0ULL;
-                            fromSquare = -1;
-                        }
-                        else
-                        {
-                            printf("DO NOTHING\n"); // DEBUG
-                        }
-                    }
-                }
-            }
-            else if ((board.getBlackRooks() >> square) & 1ULL)
-            {
-                if (ImGui::ImageButton((void*)(intptr_t)blackRookImageTexture, BOARD_TILE, uv0, uv1, 0, bg, noTint))
-                {
-                    // black turn clicking on a black rook
-                    if (board.getSide() == board.black)
-                    {
-                        // hasn't clicked on a piece yet
-                        if (!clickedOnPiece || fromSquare != square)
-                        {
-                            fromSquare = square;
-                            pieceSelected = board.blackRook;
-                            // compute possible moves and captures
-                            U64 rookMoves = board.getRookAttackBitboard(board.getOccupiedBitboard(board.both), square);
-                            possibleMoves = rookMoves & board.getEmptyBitboard();
-                            possibleCaptures = rookMoves & board.getOccupiedBitboard(board.white);
-
-                            clickedOnPiece = true;
-                            // no possible moves or captures, reset the click state
-                            if ((possibleMoves | possibleCaptures) == 0ULL)
-                            {
-                                printf("NO POSSIBLE MOVES OR CAPTURES\n"); // DEBUG
-                                clickedOnPiece = !clickedOnPiece;
-                                fromSquare = -1;
-                            }
-                        }
-                        // can't capture your own piece
-                        else
-                        {
-                            printf("CANCEL - RECLICKING SAME PIECE\n"); // DEBUG
-                            possibleMoves = 0ULL;
-                            possibleCaptures = 0ULL;
-                            fromSquare = -1;
-                            clickedOnPiece = !clickedOnPiece;
-                        }
-                    }
-                    // white turn trying to capture a black rook
-                    else
-                    {
-                        if (clickedOnPiece)
-                        {
-                            // a piece is trying to capture white rook
-                            // check if it is a valid capture
-                            if ((possibleCaptures >> square) & 1ULL)
-                            {
-                                board.popPieceBitboard(board.blackRook, square);
-                                board.popPieceBitboard(pieceSelected, fromSquare);
-                                if (pieceSelected == board.whitePawn && (fromSquare - square == 7 || fromSquare - square == 9))
-                                {
-                                    printf("CAPTURING BLACK ROOK AND PROMOTING WHITE PAWN\n"); // DEBUG
-                                    board.setPieceBitboard(board.whiteQueen, square);
-                                }
-                                else
-                                {
-                                    printf("CAPTURING BLACK ROOK\n"); // DEBUG
-                                    board.setPieceBitboard(pieceSelected, square);
-                                }
-                                board.updateOccupiedBitboards();
-                                board.updateEmptyBitboards();
-
-                                if (pieceSelected == board.whiteKing || pieceSelected == board.whiteRook)
-                                {
-                                    // white king moved, white can't castle now
-                                    printf("WHITE KING MOVED TO CAPTURE A PIECE - WHITE CANNOT CASTLE NOW\n"); // DEBUG
-                                    board.setCastlingRights(board.getCastlingRights() & 12);
-                                }
-
-                                // switch side
-                                board.flipSide();
-                                fromSquare = -1;
-                            }
-                            else
-                            {
-                                printf("CANCEL - NOT A VALID CAPTURE FOR WHITE\n"); // DEBUG
-                            }
-
-                            // reset move state
-                            clickedOnPiece = false;
-                            possibleMoves = 0ULL;
-                            possibleCaptures = 0ULL;
-                            fromSquare = -1;
-                        }
-                        else
+                        MoveList moveList;
+                        board.generateLegalMoves(moveList);
+                        for (Move move : moveList)
                         {
-                            printf("DO NOTHING\n"); // DEBUG
-                        }
-                    }
-                }
-            }
-            else if ((board.getWhiteQueens() >> square) & 1ULL)
-            {
-                if (ImGui::ImageButton((void*)(intptr_t)whiteQueenImageTexture, BOARD_TILE, uv0, uv1, 0, bg, noTint))
-                {
-                    // white turn clicking on a white queen
-                    if (board.getSide() == board.white)
-                    {
-                        // hasn't clicked on a piece yet
-                        if (!clickedOnPiece || fromSquare != square)
-                        {
-                            fromSquare = square;
-                            pieceSelected = board.whiteQueen;
-                            // compute possible moves and captures
-                            U64 queenMoves = board.getQueenAttackBitboard(board.getOccupiedBitboard(board.both), square);
-                            possibleMoves = queenMoves & board.getEmptyBitboard();
-                            possibleCaptures = queenMoves & board.getOccupiedBitboard(board.black);
+                            if (getMoveFrom(move) != square)
+                                continue;
 
-                            clickedOnPiece = true;
-                            // no possible moves or captures, reset the click state
-                            if ((possibleMoves | possibleCaptures) == 0ULL)
-                            {
-                                printf("NO POSSIBLE MOVES OR CAPTURES\n"); // DEBUG
-                                clickedOnPiece = !clickedOnPiece;
-                                fromSquare = -1;
-                            }
-                        }
-                        // can't capture your own piece
-                        else
-                        {
-                            printf("CANCEL - RECLICKING SAME PIECE\n"); // DEBUG
-                            possibleMoves = 0ULL;
-                            possibleCaptures = 0ULL;
-                            fromSquare = -1;
-                            clickedOnPiece = !clickedOnPiece;
-                        }
-                    }
-                    // black turn trying to capture a white queen
-                    else
-                    {
-                        if (clickedOnPiece)
-                        {
-                            // a piece is trying to capture white rook
-                            // check if it is a valid capture
-                            if ((possibleCaptures >> square) & 1ULL)
-                            {
-                                board.popPieceBitboard(board.whiteQueen, square);
-                                board.popPieceBitboard(pieceSelected, fromSquare);
-                                if (pieceSelected == board.blackPawn && (square - fromSquare == 7 || square - fromSquare == 9))
-                                {
-                                    printf("CAPTURING WHITE QUEEN AND PROMOTING BLACK PAWN\n"); // DEBUG
-                                    board.setPieceBitboard(board.blackQueen, square);
-                                }
-                                else
-                                {
-                                    printf("CAPTURING WHITE QUEEN\n"); // DEBUG
-                                    board.setPieceBitboard(pieceSelected, square);
-                                }
-                                board.updateOccupiedBitboards();
-                                board.updateEmptyBitboards();
-
-                                if (pieceSelected == board.blackKing || pieceSelected == board.blackRook)
-                                {
-                                    // black king moved, black can't castle now
-                                    printf("BLACK KING MOVED TO CAPTURE A PIECE - BLACK CANNOT CASTLE NOW\n"); // DEBUG
-                                    board.setCastlingRights(board.getCastlingRights() & 3);
-                                }
-
-                                // switch side
-                                board.flipSide();
-                                fromSquare = -1;
-                            }
+                            if (isCaptureMove(move))
+                                possibleCaptures |= 1ULL << getMoveTo(move);
                             else
-                            {
-                                printf("CANCEL - NOT A VALID CAPTURE FOR BLACK\n"); // DEBUG
-                            }
-
-                            // reset move state
-                            clickedOnPiece = false;
-                            possibleMoves = 0ULL;
-                            possibleCaptures = 0ULL;
-                            fromSquare = -1;
-                        }
-                        else
-                        {
-                            printf("DO NOTHING\n"); // DEBUG
+                                possibleMoves |= 1ULL << getMoveTo(move);
                         }
-                    }
-                }
-            }
-            else if ((board.getBlackQueens() >> square) & 1ULL)
-            {
-                if (ImGui::ImageButton((void*)(intptr_t)blackQueenImageTexture, BOARD_TILE, uv0, uv1, 0, bg, noTint))
-                {
-                    // black turn clicking on a black queen
-                    if (board.getSide() == board.black)
-                    {
-                        // hasn't clicked on a piece yet
-                        if (!clickedOnPiece || fromSquare != square)
-                        {
-                            fromSquare = square;
-                            pieceSelected = board.blackQueen;
-                            // compute possible moves and captures
-                            U64 queenMoves = board.getQueenAttackBitboard(board.getOccupiedBitboard(board.both), square);
-                            possibleMoves = queenMoves & board.getEmptyBitboard();
-                            possibleCaptures = queenMoves & board.getOccupiedBitboard(board.white);
 
-                            clickedOnPiece = true;
-                            // no possible moves or captures, reset the click state
-                            if ((possibleMoves | possibleCaptures) == 0ULL)
-                            {
-                                printf("NO POSSIBLE MOVES OR CAPTURES\n"); // DEBUG
-                                clickedOnPiece = !clickedOnPiece;
-                                fromSquare = -1;
-                            }
-                        }
-                        // can't capture your own piece
-                        else
-                        {
-                            printf("CANCEL - RECLICKING SAME PIECE\n"); // DEBUG
-                            possibleMoves = 0ULL;
-                            possibleCaptures = 0ULL;
-                            fromSquare = -1;
-                            clickedOnPiece = !clickedOnPiece;
-                        }
-                    }
-                    // white turn trying to capture a black queen
-                    else
-                    {
-                        if (clickedOnPiece)
+                        clickedOnPiece = true;
+                        // no possible moves or captures, reset the click state
+                        if ((possibleMoves | possibleCaptures) == 0ULL)
                         {
-                            // a piece is trying to capture white rook
-                            // check if it is a valid capture
-                            if ((possibleCaptures >> square) & 1ULL)
-                            {
-                                board.popPieceBitboard(board.blackQueen, square);
-                                board.popPieceBitboard(pieceSelected, fromSquare);
-                                if (pieceSelected == board.whitePawn && (fromSquare - square == 7 || fromSquare - square == 9))
-                                {
-                                    printf("CAPTURING BLACK QUEEN AND PROMOTING WHITE PAWN\n"); // DEBUG
-                                    board.setPieceBitboard(board.whiteQueen, square);
-                                }
-                                else
-                                {
-                                    printf("CAPTURING BLACK QUEEN\n"); // DEBUG
-                                    board.setPieceBitboard(pieceSelected, square);
-                                }
-                                board.updateOccupiedBitboards();
-                                board.updateEmptyBitboards();
-
-                                if (pieceSelected == board.whiteKing || pieceSelected == board.whiteRook)
-                                {
-                                    // white king moved, white can't castle now
-                                    printf("WHITE KING MOVED TO CAPTURE A PIECE - WHITE CANNOT CASTLE NOW\n"); // DEBUG
-                                    board.setCastlingRights(board.getCastlingRights() & 12);
-                                }
-
-                                // switch side
-                                board.flipSide();
-                                fromSquare = -1;
-                            }
-                            else
-                            {
-                                printf("CANCEL - NOT A VALID CAPTURE FOR WHITE\n"); // DEBUG
-                            }
-
-                            // reset move state
                             clickedOnPiece = false;
-                            possibleMoves = 0ULL;
-                            possibleCaptures = 0ULL;
-                            fromSquare = -1;
-                        }
-                        else
-                        {
-                            printf("DO NOTHING\n"); // DEBUG
-                        }
-                    }
-                }
-            }
-            else if ((board.getWhiteKing() >> square) & 1ULL)
-            {
-                if (ImGui::ImageButton((void*)(intptr_t)whiteKingImageTexture, BOARD_TILE, uv0, uv1, 0, bg, noTint))
-                {
-                    // white turn clicking on a white king
-                    if (board.getSide() == board.white)
-                    {
-                        // hasn't clicked on a piece yet
-                        if (!clickedOnPiece || fromSquare != square)
-                        {
-                            fromSquare = square;
-                            pieceSelected = board.whiteKing;
-                            // compute possible moves and captures
-                            U64 emptyBitboard = board.getEmptyBitboard();
-                            possibleMoves = kingAttackTable[square] & emptyBitboard;
-                            possibleCaptures = kingAttackTable[square] & board.getOccupiedBitboard(board.black);
-
-                            // compute possible castling
-                            if ((board.getCastlingRights() & board.whiteKingSide) && (board.getWhiteRooks() & (1ULL << board.h1)))
-                            {
-                                // white king side castling
-                                if (((emptyBitboard >> board.f1) & 1ULL) && ((emptyBitboard >> board.g1) & 1ULL))
-                                {
-                                    // the castling squares are empty
-                                    // check if the castling squares are attacked
-                                    if (!(board.isSquareAttacked(board.black, board.e1)) && !(board.isSquareAttacked(board.black, board.f1)) && !(board.isSquareAttacked(board.black, board.g1)))
-                                    {
-                                        printf("WHITE KING SIDE CASTLING IS POSSIBLE\n"); // DEBUG
-                                        possibleMoves |= (1ULL << board.g1);
-                                    }
-                                    else
-                                    {
-                                        printf("WHITE KING SIDE CASTLING IS NOT POSSIBLE - ONE OF THE CASTLING SQUARES ARE ATTACKED\n"); // DEBUG
-                                    }
-                                }
-                                else
-                                {
-                                    printf("WHITE KING SIDE CASTLING IS NOT POSSIBLE - A PIECE IS BLOCKING THE WAY\n"); // DEBUG
-                                }
-                            }
-
-                            // compute possible castling
-                            if ((board.getCastlingRights() & board.whiteQueenSide) && (board.getWhiteRooks() & (1ULL << board.a1)))
-                            {
-                                // white queen side castling
-                                if (((emptyBitboard >> board.b1) & 1ULL) && ((emptyBitboard >> board.c1) & 1ULL) && ((emptyBitboard >> board.d1) & 1ULL))
-                                {
-                                    // the castling squares are empty
-                                    // check if the castling squares are attacked
-                                    if (!(board.isSquareAttacked(board.black, board.e1)) && !(board.isSquareAttacked(board.black, board.d1)) && !(board.isSquareAttacked(board.black, board.c1)))
-                                    {
-                                        printf("WHITE QUEEN SIDE CASTLING IS POSSIBLE\n"); // DEBUG
-                                        possibleMoves |= (1ULL << board.c1);
-                                    }
-                                    else
-                                    {
-                                        printf("WHITE QUEEN SIDE CASTLING IS NOT POSSIBLE - ONE OF THE CASTLING SQUARES ARE ATTACKED\n"); // DEBUG
-                                    }
-                                }
-                                else
-                                {
-                                    printf("WHITE QUEEN SIDE CASTLING IS NOT POSSIBLE - A PIECE IS BLOCKING THE WAY\n"); // DEBUG
-                                }
-                            }
-
-                            clickedOnPiece = true;
-                            // no possible moves or captures, reset the click state
-                            if ((possibleMoves | possibleCaptures) == 0ULL)
-                            {
-                                printf("NO POSSIBLE MOVES OR CAPTURES\n"); // DEBUG
-                                clickedOnPiece = !clickedOnPiece;
-                                fromSquare = -1;
-                            }
-                        }
-                        // can't capture your own piece
-                        else
-                        {
-                            printf("CANCEL - RECLICKING SAME PIECE\n"); // DEBUG
-                            possibleMoves = 0ULL;
-                            possibleCaptures = 0ULL;
                             fromSquare = -1;
-                            clickedOnPiece = !clickedOnPiece;
                         }
                     }
-                    // black turn trying to capture a white king
+                    // clicking the selected piece again cancels the selection
                     else
                     {
-                        if (clickedOnPiece)
-                        {
-                            // a piece is trying to capture white king
-                            // check if it is a valid capture
-                            if ((possibleCaptures >> square) & 1ULL)
-                            {
-                                printf("CAPTURING WHITE KING\n"); // DEBUG
-                                board.popPieceBitboard(board.whiteKing, square);
-                                board.popPieceBitboard(pieceSelected, fromSquare);
-                                board.setPieceBitboard(pieceSelected, square);
-                                board.updateOccupiedBitboards();
-                                board.updateEmptyBitboards();
-
-                                // switch side
-                                board.flipSide();
-                            }
-                            else
-                            {
-                                printf("CANCEL - NOT A VALID CAPTURE FOR BLACK\n"); // DEBUG
-                            }
-
-                            // reset move state
-                            clickedOnPiece = false;
-                            possibleMoves = 0ULL;
-                            possibleCaptures = 0ULL;
-                            fromSquare = -1;
-                        }
-                        else
-                        {
-                            printf("DO NOTHING\n"); // DEBUG
-                        }
+                        possibleMoves = 0ULL;
+                        possibleCaptures = 0ULL;
+                        fromSquare = -1;
+                        clickedOnPiece = false;
                     }
                 }
-            }
-            else if ((board.getBlackKing() >> square) & 1ULL)
-            {
-                if (ImGui::ImageButton((void*)(intptr_t)blackKingImageTexture, BOARD_TILE, uv0, uv1, 0, bg, noTint))
+                // clicked on an empty square or an enemy piece after selecting a piece, validate the move
+                else if (clickedOnPiece)
                 {
-                    // black turn clicking on a black king
-                    if (board.getSide() == board.black)
+                    // pawns reaching the last rank always promote to a queen
+                    Move selectedMove = noMove;
+                    MoveList moveList;
+                    board.generateLegalMoves(moveList);
+                    for (Move move : moveList)
                     {
-                        // hasn't clicked on a piece yet
-                        if (!clickedOnPiece || fromSquare != square)
-                        {
-                            fromSquare = square;
-                            pieceSelected = board.blackKing;
-                            // compute possible moves and captures
-                            U64 emptyBitboard = board.getEmptyBitboard();
-                            possibleMoves = kingAttackTable[square] & emptyBitboard;
-                            possibleCaptures = kingAttackTable[square] & board.getOccupiedBitboard(board.white);
-
-                            // compute possible castling
-                            if (board.getCastlingRights() & board.blackKingSide && (board.getBlackRooks() & (1ULL << board.h8)))
-                            {
-                                // black king side castling
-                                if (((emptyBitboard >> board.f8) & 1ULL) && ((emptyBitboard >> board.g8) & 1ULL))
-                                {
-                                    // the castling squares are empty
-                                    // check if the castling squares are attacked
-                                    if (!(board.isSquareAttacked(board.white, board.e8)) && !(board.isSquareAttacked(board.white, board.f8)) && !(board.isSquareAttacked(board.white, board.g8)))
-                                    {
-                                        printf("BLACK KING SIDE CASTLING IS POSSIBLE\n"); // DEBUG
-                                        possibleMoves |= (1ULL << board.g8);
-                                    }
-                                    else
-                                    {
-                                        printf("BLACK KING SIDE CASTLING IS NOT POSSIBLE - ONE OF THE CASTLING SQUARES ARE ATTACKED\n"); // DEBUG
-                                    }
-                                }
-                                else
-                                {
-                                    printf("BLACK KING SIDE CASTLING IS NOT POSSIBLE - A PIECE IS BLOCKING THE WAY\n"); // DEBUG
-                                }
-                            }
-
-                            // compute possible castling
-                            if (board.getCastlingRights() & board.blackQueenSide && (board.getBlackRooks() & (1ULL << board.a8)))
-                            {
-                                // black queen side castling
-                                if (((emptyBitboard >> board.b8) & 1ULL) && ((emptyBitboard >> board.c8) & 1ULL) && ((emptyBitboard >> board.d8) & 1ULL))
-                                {
-                                    // the castling squares are empty
-                                    // check if the castling squares are attacked
-                                    if (!(board.isSquareAttacked(board.white, board.e8)) && !(board.isSquareAttacked(board.white, board.d8)) && !(board.isSquareAttacked(board.white, board.c8)))
-                                    {
-                                        printf("BLACK QUEEN SIDE CASTLING IS POSSIBLE\n"); // DEBUG
-                                        possibleMoves |= (1ULL << board.c8);
-                                    }
-                                    else
-                                    {
-                                        printf("BLACK QUEEN SIDE CASTLING IS NOT POSSIBLE - ONE OF THE CASTLING SQUARES ARE ATTACKED\n"); // DEBUG
-                                    }
-                                }
-                                else
-                                {
-                                    printf("BLACK QUEEN SIDE CASTLING IS NOT POSSIBLE - A PIECE IS BLOCKING THE WAY\n"); // DEBUG
-                                }
-                            }
-
-                            clickedOnPiece = true;
-                            // no possible moves or captures, reset the click state
-                            if ((possibleMoves | possibleCaptures) == 0ULL)
-                            {
-                                printf("NO POSSIBLE MOVES OR CAPTURES\n"); // DEBUG
-                                clickedOnPiece = !clickedOnPiece;
-                                fromSquare = -1;
-                            }
-                        }
-                        // can't capture your own piece
-                        else
-                        {
-                            printf("CANCEL - RECLICKING SAME PIECE\n"); // DEBUG
-                            possibleMoves = 0ULL;
-                            possibleCaptures = 0ULL;
-                            fromSquare = -1;
-                            clickedOnPiece = !clickedOnPiece;
-                        }
+                        if (getMoveFrom(move) == fromSquare && getMoveTo(move) == square
+                            && (!isPromotionMove(move) || getPromotionPiece(move, board.white) == board.whiteQueen))
+                            selectedMove = move;
                     }
-                    // white turn trying to capture a black king
-                    else
-                    {
-                        if (clickedOnPiece)
-                        {
-                            // a piece is trying to capture black king
-                            // check if it is a valid capture
-                            if ((possibleCaptures >> square) & 1ULL)
-                            {
-                                printf("CAPTURING BLACK KING\n"); // DEBUG
-                                board.popPieceBitboard(board.blackKing, square);
-                                board.popPieceBitboard(pieceSelected, fromSquare);
-                                board.setPieceBitboard(pieceSelected, square);
-                                board.updateOccupiedBitboards();
-                                board.updateEmptyBitboards();
 
-                                // switch side
-                                board.flipSide();
-                            }
-                            else
-                            {
-                                printf("CANCEL - NOT A VALID CAPTURE FOR WHITE\n"); // DEBUG
-                            }
+                    // an illegal target square only drops the selection
+                    if (selectedMove != noMove)
+                        board.makeMove(selectedMove);
 
-                            // reset move state
-                            clickedOnPiece = false;
-                            possibleMoves = 0ULL;
-                            possibleCaptures = 0ULL;
-                            fromSquare = -1;
-                        }
-                        else
-                        {
-                            printf("DO NOTHING\n"); // DEBUG
-                        }
-                    }
+                    // reset move state
+                    clickedOnPiece = false;
+                    possibleMoves = 0ULL;
+                    possibleCaptures = 0ULL;
+                    fromSquare = -1;
                 }
             }
 
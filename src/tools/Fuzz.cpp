@@ -0,0 +1,454 @@
+#include "Board.h"
+#include "Fen.h"
+#include "SetwiseAttacks.h"
+
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// differential tester, checks the fast paths against slow references on random inputs
+//
+//   fuzz [-n slider cases] [-p playouts] [-s seed]
+//
+// slider lookups of every backend and the setwise fills are compared to the *Runtime ray walks.
+// random positions, placed directly or reached by random playouts from the perft positions, check
+// attack queries against a reference built on the ray walks, legal generation against pseudo-legal
+// generation filtered by the reference, and that every move's make/unmake restores the position,
+// Zobrist key and mailbox exactly
+
+static const char* rootFens[] = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+};
+
+static const int maxFailures = 10;
+static const int playoutLength = 48;
+
+static U64 randomState = 1070372ULL;
+static int failureCount = 0;
+
+static U64 getRandomU64()
+{
+    // xorshift64*
+    randomState ^= randomState >> 12;
+    randomState ^= randomState << 25;
+    randomState ^= randomState >> 27;
+    return randomState * 2685821657736338717ULL;
+}
+
+// sparse to dense occupancies, the interesting cases are the ones with blockers on the rays
+static U64 getRandomOccupancy()
+{
+    switch (getRandomU64() & 3)
+    {
+        case 0:
+            return getRandomU64() & getRandomU64() & getRandomU64();
+        case 1:
+            return getRandomU64() & getRandomU64();
+        case 2:
+            return getRandomU64();
+        default:
+            return getRandomU64() | getRandomU64();
+    }
+}
+
+static void reportFailure(const Board* board, const char* what, Move move)
+{
+    failureCount++;
+    if (failureCount > maxFailures)
+        return;
+
+    printf("FAILED %s", what);
+    if (move != noMove)
+    {
+        char moveString[6];
+        getMoveString(move, moveString);
+        printf(" after %s", moveString);
+    }
+    if (board)
+    {
+        char fen[96];
+        getFEN(*board, fen);
+        printf(" in %s", fen);
+    }
+    printf("\n");
+}
+
+static void reportSliderFailure(const char* what, U64 occ, int square)
+{
+    failureCount++;
+    if (failureCount <= maxFailures)
+        printf("FAILED %s on square %d occupancy 0x%016llx\n", what, square, occ);
+}
+
+static void fuzzSliders(long long caseCount)
+{
+    bool hasPext = cpuHasPext();
+    for (long long i = 0; i < caseCount; ++i)
+    {
+        U64 occ = getRandomOccupancy();
+        int square = (int)(getRandomU64() & 63);
+
+        U64 bishop = Board::getBishopAttackBitboardRuntime(occ, square);
+        U64 rook = Board::getRookAttackBitboardRuntime(occ, square);
+
+        if (Board::getBishopAttackBitboardMagic(occ, square) != bishop)
+            reportSliderFailure("magic bishop", occ, square);
+        if (Board::getRookAttackBitboardMagic(occ, square) != rook)
+            reportSliderFailure("magic rook", occ, square);
+        if (hasPext && Board::getBishopAttackBitboardPext(occ, square) != bishop)
+            reportSliderFailure("pext bishop", occ, square);
+        if (hasPext && Board::getRookAttackBitboardPext(occ, square) != rook)
+            reportSliderFailure("pext rook", occ, square);
+        if (Board::getQueenAttackBitboard(occ, square) != (bishop | rook))
+            reportSliderFailure("queen", occ, square);
+    }
+}
+
+static void fuzzSetwise(long long caseCount)
+{
+    bool hasAvx2 = cpuHasAvx2();
+    for (long long i = 0; i < caseCount; ++i)
+    {
+        U64 occ = getRandomOccupancy();
+        U64 rooks = occ & getRandomU64() & getRandomU64() & getRandomU64();
+        U64 bishops = occ & getRandomU64() & getRandomU64() & getRandomU64();
+
+        U64 rookAttacks = 0ULL;
+        U64 bishopAttacks = 0ULL;
+        for (U64 set = rooks; set; )
+            rookAttacks |= Board::getRookAttackBitboardRuntime(occ, popLSB(set));
+        for (U64 set = bishops; set; )
+            bishopAttacks |= Board::getBishopAttackBitboardRuntime(occ, popLSB(set));
+
+        if (getRookAttacksSetwise(rooks, occ) != rookAttacks)
+            reportSliderFailure("setwise rooks", occ, getLSB(rooks));
+        if (getBishopAttacksSetwise(bishops, occ) != bishopAttacks)
+            reportSliderFailure("setwise bishops", occ, getLSB(bishops));
+        if (getSliderAttacksSetwiseScalar(rooks, bishops, occ) != (rookAttacks | bishopAttacks))
+            reportSliderFailure("setwise scalar sliders", occ, getLSB(rooks | bishops));
+        if (hasAvx2 && getSliderAttacksSetwiseAvx2(rooks, bishops, occ) != (rookAttacks | bishopAttacks))
+            reportSliderFailure("setwise avx2 sliders", occ, getLSB(rooks | bishops));
+    }
+}
+
+// attackers of both colours from the lookup tables and the ray walks, no fast slider path involved
+static U64 getReferenceAttackers(const Position& pos, int square)
+{
+    const U64* pieces = pos.pieces;
+    U64 occ = pos.occupied[Board::both];
+
+    return (pawnAttackTable[Board::black][square] & pieces[Board::whitePawn])
+        | (pawnAttackTable[Board::white][square] & pieces[Board::blackPawn])
+        | (knightAttackTable[square] & (pieces[Board::whiteKnight] | pieces[Board::blackKnight]))
+        | (kingAttackTable[square] & (pieces[Board::whiteKing] | pieces[Board::blackKing]))
+        | (Board::getBishopAttackBitboardRuntime(occ, square)
+            & (pieces[Board::whiteBishop] | pieces[Board::blackBishop] | pieces[Board::whiteQueen] | pieces[Board::blackQueen]))
+        | (Board::getRookAttackBitboardRuntime(occ, square)
+            & (pieces[Board::whiteRook] | pieces[Board::blackRook] | pieces[Board::whiteQueen] | pieces[Board::blackQueen]));
+}
+
+static bool isKingAttackedReference(const Position& pos, int side)
+{
+    int kingSquare = getLSB(pos.pieces[Board::whiteKing + side]);
+    return (getReferenceAttackers(pos, kingSquare) & pos.occupied[!side]) != 0;
+}
+
+// bitboards, occupancy, mailbox and key agree with each other
+static bool isConsistent(const Board& board)
+{
+    const Position& pos = board.getPosition();
+
+    U64 sides[2] = { 0ULL, 0ULL };
+    for (int piece = 0; piece < 12; ++piece)
+        sides[piece & 1] |= pos.pieces[piece];
+    if (sides[0] != pos.occupied[0] || sides[1] != pos.occupied[1] || (sides[0] | sides[1]) != pos.occupied[2])
+        return false;
+
+    for (int square = 0; square < 64; ++square)
+    {
+        int piece = board.getPieceOn(square);
+        if (piece == Board::noPiece ? getBit(pos.occupied[Board::both], square) != 0 : getBit(pos.pieces[piece], square) == 0)
+            return false;
+    }
+
+    return board.getKey() == board.computeKey();
+}
+
+static void sortMoves(MoveList& list)
+{
+    std::sort(list.moves, list.moves + list.count);
+}
+
+static bool isSameMoves(MoveList& a, MoveList& b)
+{
+    sortMoves(a);
+    sortMoves(b);
+    return a.count == b.count && std::equal(a.moves, a.moves + a.count, b.moves);
+}
+
+// runs every check on the current position and leaves its legal moves in legalMoves
+static void checkPosition(Board& board, MoveList& legalMoves)
+{
+    const Position& pos = board.getPosition();
+    int side = board.getSide();
+
+    if (!isConsistent(board))
+        reportFailure(&board, "bitboard/mailbox/key consistency", noMove);
+
+    // attack queries
+    U64 sideAttacks[2] = { 0ULL, 0ULL };
+    for (int square = 0; square < 64; ++square)
+    {
+        U64 attackers = getReferenceAttackers(pos, square);
+        if (board.attackersTo(square, pos.occupied[Board::both]) != attackers)
+            reportFailure(&board, "attackersTo", noMove);
+
+        for (int color = 0; color < 2; ++color)
+        {
+            bool isAttacked = (attackers & pos.occupied[color]) != 0;
+            if (isAttacked)
+                sideAttacks[color] |= 1ULL << square;
+            if (board.isSquareAttacked(color, square) != isAttacked)
+                reportFailure(&board, "isSquareAttacked", noMove);
+        }
+    }
+    for (int color = 0; color < 2; ++color)
+    {
+        if (board.getSideAttacks(color) != sideAttacks[color])
+            reportFailure(&board, "getSideAttacks", noMove);
+        if (board.isTrackingAttackMaps() && board.getAttackMap(color) != sideAttacks[color])
+            reportFailure(&board, "incremental attack map", noMove);
+    }
+
+    // the pseudo-legal list splits into captures and quiets, and every move in it is recognised
+    MoveList pseudoMoves, captures, quiets;
+    board.generatePseudoLegalMoves(pseudoMoves);
+    board.generatePseudoLegalMoves(captures, captureMoves);
+    board.generatePseudoLegalMoves(quiets, quietMoves);
+
+    MoveList joined = captures;
+    for (Move move : quiets)
+        joined.add(move);
+    if (!isSameMoves(joined, pseudoMoves))
+        reportFailure(&board, "captures + quiets != all pseudo-legal moves", noMove);
+
+    for (Move move : pseudoMoves)
+    {
+        if (!board.isPseudoLegal(move))
+            reportFailure(&board, "isPseudoLegal rejects a generated move", move);
+    }
+    for (int i = 0; i < 16; ++i)
+    {
+        Move move = (Move)getRandomU64();
+        bool isGenerated = std::find(pseudoMoves.begin(), pseudoMoves.end(), move) != pseudoMoves.end();
+        if (board.isPseudoLegal(move) != isGenerated)
+            reportFailure(&board, "isPseudoLegal on a random move", move);
+    }
+
+    // every pseudo-legal move is played and taken back, the ones that don't leave the king attacked are legal
+    Position saved = pos;
+    U64 savedKey = board.getKey();
+    U64 savedAttackMaps[2] = { board.getAttackMap(Board::white), board.getAttackMap(Board::black) };
+    MoveList filteredMoves;
+    for (Move move : pseudoMoves)
+    {
+        board.makeMove(move);
+        if (!isConsistent(board))
+            reportFailure(&board, "bitboard/mailbox/key consistency", move);
+        if (board.isTrackingAttackMaps()
+            && (board.getAttackMap(Board::white) != board.getSideAttacks(Board::white)
+                || board.getAttackMap(Board::black) != board.getSideAttacks(Board::black)))
+            reportFailure(&board, "incremental attack map", move);
+        if (!isKingAttackedReference(board.getPosition(), side))
+            filteredMoves.add(move);
+        board.unmakeMove();
+
+        if (memcmp(&board.getPosition(), &saved, sizeof(Position)) || board.getKey() != savedKey || !isConsistent(board))
+            reportFailure(&board, "unmakeMove did not restore the position", move);
+        if (board.getAttackMap(Board::white) != savedAttackMaps[Board::white] || board.getAttackMap(Board::black) != savedAttackMaps[Board::black])
+            reportFailure(&board, "unmakeMove did not restore the attack maps", move);
+    }
+
+    board.generateLegalMoves(legalMoves);
+    MoveList generatedMoves = legalMoves;
+    if (!isSameMoves(generatedMoves, filteredMoves))
+        reportFailure(&board, "legal moves != filtered pseudo-legal moves", noMove);
+
+    if (board.isInCheck(side) != isKingAttackedReference(pos, side))
+        reportFailure(&board, "isInCheck", noMove);
+}
+
+// a random placement with both kings apart and the side not to move out of check, castling rights
+// where king and rook are home and an en passant square where a double push could have happened
+static void setupRandomPosition(Board& board)
+{
+    while (true)
+    {
+        board.resetBoard();
+
+        unsigned char squares[64];
+        memset(squares, Board::noPiece, sizeof(squares));
+
+        int whiteKingSquare = (int)(getRandomU64() & 63);
+        int blackKingSquare;
+        do
+            blackKingSquare = (int)(getRandomU64() & 63);
+        while (blackKingSquare == whiteKingSquare || getBit(kingAttackTable[whiteKingSquare], blackKingSquare));
+        squares[whiteKingSquare] = Board::whiteKing;
+        squares[blackKingSquare] = Board::blackKing;
+
+        // pawns most often, queens least
+        static const int pieceTypes[] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4 };
+        int pieceCount = (int)(getRandomU64() % 24);
+        for (int i = 0; i < pieceCount; ++i)
+        {
+            int square = (int)(getRandomU64() & 63);
+            int piece = pieceTypes[getRandomU64() % 11] * 2 + (int)(getRandomU64() & 1);
+            bool isPawn = piece >> 1 == 0;
+            if (squares[square] != Board::noPiece || (isPawn && (square < 8 || square >= 56)))
+                continue;
+            squares[square] = (unsigned char)piece;
+        }
+
+        for (int square = 0; square < 64; ++square)
+        {
+            int piece = squares[square];
+            if (piece == Board::noPiece)
+                continue;
+            board.setPieceBitboard((Board::PieceTypes)piece, square);
+            board.setOccupiedBitboardSquare(piece & 1, square);
+            board.setOccupiedBitboardSquare(Board::both, square);
+        }
+
+        int side = (int)(getRandomU64() & 1);
+        board.setSide(side);
+
+        int castle = 0;
+        if (squares[60] == Board::whiteKing && squares[63] == Board::whiteRook)
+            castle |= Board::whiteKingSide;
+        if (squares[60] == Board::whiteKing && squares[56] == Board::whiteRook)
+            castle |= Board::whiteQueenSide;
+        if (squares[4] == Board::blackKing && squares[7] == Board::blackRook)
+            castle |= Board::blackKingSide;
+        if (squares[4] == Board::blackKing && squares[0] == Board::blackRook)
+            castle |= Board::blackQueenSide;
+        board.setCastlingRights(castle & (int)getRandomU64());
+
+        // the pawn that just moved two squares stands on the fourth rank from its side
+        int pushedPawn = side == Board::white ? Board::blackPawn : Board::whitePawn;
+        int firstSquare = side == Board::white ? 24 : 32;
+        int direction = side == Board::white ? -8 : 8;
+        for (int square = firstSquare; square < firstSquare + 8; ++square)
+        {
+            if (squares[square] == pushedPawn && squares[square + direction] == Board::noPiece
+                && squares[square + 2 * direction] == Board::noPiece && (getRandomU64() & 1))
+            {
+                board.setEnPassantSquare(square + direction);
+                break;
+            }
+        }
+
+        board.updateOccupiedBitboards();
+        if (!isKingAttackedReference(board.getPosition(), !side))
+            return;
+    }
+}
+
+// writes the position out as FEN and reads it back into a second board
+static void checkFenRoundTrip(const Board& board)
+{
+    static Board parsed;
+    char fen[96];
+    getFEN(board, fen);
+
+    parsed.resetBoard();
+    if (!parseFEN(&parsed, fen)
+        || memcmp(&parsed.getPosition(), &board.getPosition(), sizeof(Position))
+        || parsed.getKey() != board.getKey())
+        reportFailure(&board, "FEN round trip", noMove);
+}
+
+int main(int argc, char** argv)
+{
+    long long sliderCases = 10000000;
+    long long playoutCount = 5000;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "-n") && i + 1 < argc)
+            sliderCases = atoll(argv[++i]);
+        else if (!strcmp(argv[i], "-p") && i + 1 < argc)
+            playoutCount = atoll(argv[++i]);
+        else if (!strcmp(argv[i], "-s") && i + 1 < argc)
+            randomState = strtoull(argv[++i], nullptr, 0) | 1;
+        else
+        {
+            printf("usage: %s [-n slider cases] [-p playouts] [-s seed]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    printf("seed 0x%llx, pext %s, avx2 %s\n\n", randomState, cpuHasPext() ? "yes" : "no", cpuHasAvx2() ? "yes" : "no");
+
+    auto start = std::chrono::steady_clock::now();
+    fuzzSliders(sliderCases);
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    printf("%-10s %12lld cases     %7.2f s %8.2f Mcases/s\n", "sliders", sliderCases, seconds, sliderCases / seconds / 1e6);
+
+    start = std::chrono::steady_clock::now();
+    fuzzSetwise(sliderCases / 4);
+    end = std::chrono::steady_clock::now();
+    seconds = std::chrono::duration<double>(end - start).count();
+    printf("%-10s %12lld cases     %7.2f s %8.2f Mcases/s\n", "setwise", sliderCases / 4, seconds, sliderCases / 4 / seconds / 1e6);
+
+    // half the playouts start from a random placement, half from a perft position, and every
+    // other one tracks attack maps incrementally
+    static Board board;
+    long long positionCount = 0;
+    start = std::chrono::steady_clock::now();
+    for (long long i = 0; i < playoutCount && failureCount == 0; ++i)
+    {
+        if (i & 1)
+        {
+            board.resetBoard();
+            parseFEN(&board, rootFens[getRandomU64() % 6]);
+        }
+        else
+        {
+            setupRandomPosition(board);
+        }
+        board.setAttackMapTracking((i & 2) != 0);
+
+        for (int ply = 0; ply < playoutLength && failureCount == 0; ++ply)
+        {
+            MoveList legalMoves;
+            checkFenRoundTrip(board);
+            checkPosition(board, legalMoves);
+            positionCount++;
+
+            if (legalMoves.size() == 0)
+                break;
+            board.makeMove(legalMoves[(int)(getRandomU64() % legalMoves.size())]);
+        }
+    }
+    end = std::chrono::steady_clock::now();
+    seconds = std::chrono::duration<double>(end - start).count();
+    printf("%-10s %12lld positions %7.2f s %8.2f Mpositions/s\n", "positions", positionCount, seconds, positionCount / seconds / 1e6);
+
+    if (failureCount)
+    {
+        printf("\n%d failure(s)\n", failureCount);
+        return 1;
+    }
+
+    printf("\nall ok\n");
+    return 0;
+}
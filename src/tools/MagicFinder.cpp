@@ -0,0 +1,252 @@
+#include "Board.h"
+
+#include <atomic>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+// searches bishop and rook magic numbers for all 64 squares in parallel and writes MagicNumbers.h
+//
+//   magic_finder [-t threads] [-n attempts] [-o file]
+//
+// every square first gets a magic with one index bit per mask bit, then the search tries to drop
+// index bits, which only works when occupancies with identical attacks land on the same entry
+
+struct MagicJob
+{
+    int square;
+    bool isBishop;
+
+    // search result
+    U64 magicNumber;
+    int bitCount;
+};
+
+// everything needed to verify a candidate for one square
+struct MagicSearch
+{
+    U64 maskBitboard;
+    int occupancyCount;
+    U64 occupancies[4096];
+    U64 attacks[4096];
+
+    // a slot is in use for the current candidate when its epoch matches, which saves a memset per try
+    U64 usedAttacks[4096];
+    unsigned int usedEpoch[4096];
+    unsigned int epoch;
+
+    U64 randomState;
+};
+
+static U64 getRandomU64(MagicSearch* search)
+{
+    // xorshift64*
+    search->randomState ^= search->randomState >> 12;
+    search->randomState ^= search->randomState << 25;
+    search->randomState ^= search->randomState >> 27;
+    return search->randomState * 2685821657736338717ULL;
+}
+
+static U64 generateMagicNumber(MagicSearch* search)
+{
+    // magics with few set bits work far more often
+    return getRandomU64(search) & getRandomU64(search) & getRandomU64(search);
+}
+
+// a magic is valid when every occupancy maps to a free entry or to one holding the same attacks
+static bool isValidMagic(MagicSearch* search, U64 magicNumber, int bitCount)
+{
+    search->epoch++;
+
+    for (int i = 0; i < search->occupancyCount; ++i)
+    {
+        int magicIndex = (int)((search->occupancies[i] * magicNumber) >> (64 - bitCount));
+
+        if (search->usedEpoch[magicIndex] != search->epoch)
+        {
+            search->usedEpoch[magicIndex] = search->epoch;
+            search->usedAttacks[magicIndex] = search->attacks[i];
+        }
+        else if (search->usedAttacks[magicIndex] != search->attacks[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static U64 findMagicNumber(MagicSearch* search, int bitCount, long long attempts)
+{
+    for (long long attempt = 0; attempt < attempts; ++attempt)
+    {
+        U64 magicNumber = generateMagicNumber(search);
+
+        // the top byte of the product has to be dense enough to spread the indices
+        if (countBits((search->maskBitboard * magicNumber) & 0xFF00000000000000ULL) < 6)
+            continue;
+
+        if (isValidMagic(search, magicNumber, bitCount))
+            return magicNumber;
+    }
+
+    return 0ULL;
+}
+
+static void runMagicJob(MagicJob* job, long long attempts)
+{
+    MagicSearch* search = new MagicSearch();
+    int square = job->square;
+
+    search->maskBitboard = job->isBishop ? Board::getBishopMaskBitboard(square) : Board::getRookMaskBitboard(square);
+    int maskBitCount = countBits(search->maskBitboard);
+    search->occupancyCount = 1 << maskBitCount;
+    search->randomState = 0x9E3779B97F4A7C15ULL * (square + 1) + (job->isBishop ? 0 : 64);
+
+    for (int i = 0; i < search->occupancyCount; ++i)
+    {
+        search->occupancies[i] = Board::setOccupancy(search->maskBitboard, i, maskBitCount);
+        search->attacks[i] = job->isBishop ? Board::getBishopAttackBitboardRuntime(search->occupancies[i], square) : Board::getRookAttackBitboardRuntime(search->occupancies[i], square);
+    }
+
+    // a plain magic always exists, keep looking until one turns up
+    job->bitCount = maskBitCount;
+    job->magicNumber = 0ULL;
+    while (!job->magicNumber)
+        job->magicNumber = findMagicNumber(search, maskBitCount, attempts);
+
+    // then try for denser tables, one index bit at a time
+    while (job->bitCount > 1)
+    {
+        U64 magicNumber = findMagicNumber(search, job->bitCount - 1, attempts);
+        if (!magicNumber)
+            break;
+
+        job->magicNumber = magicNumber;
+        job->bitCount--;
+    }
+
+    delete search;
+}
+
+static void writeMagicArray(FILE* file, const char* name, const MagicJob* jobs)
+{
+    fprintf(file, "inline constexpr U64 %s[64] = {\n", name);
+    for (int square = 0; square < 64; ++square)
+        fprintf(file, "    0x%llxULL%s\n", jobs[square].magicNumber, square < 63 ? "," : "");
+    fprintf(file, "};\n");
+}
+
+static void writeBitCountArray(FILE* file, const char* name, const MagicJob* jobs)
+{
+    fprintf(file, "inline constexpr int %s[64] = {\n", name);
+    for (int rank = 0; rank < 8; ++rank)
+    {
+        fprintf(file, "   ");
+        for (int column = 0; column < 8; ++column)
+            fprintf(file, " %d,", jobs[rank * 8 + column].bitCount);
+        fprintf(file, "\n");
+    }
+    fprintf(file, "};\n");
+}
+
+static int getTableSize(const MagicJob* jobs)
+{
+    int size = 0;
+    for (int square = 0; square < 64; ++square)
+        size += 1 << jobs[square].bitCount;
+    return size;
+}
+
+static bool writeMagicHeader(const char* path, const MagicJob* bishopJobs, const MagicJob* rookJobs)
+{
+    FILE* file = fopen(path, "w");
+    if (!file)
+        return false;
+
+    int bishopSize = getTableSize(bishopJobs);
+    int rookSize = getTableSize(rookJobs);
+
+    fprintf(file, "// Generated by src/tools/magic_finder, regenerate instead of editing by hand.\n");
+    fprintf(file, "// bishop table: %d entries, rook table: %d entries, %d KB in total\n", bishopSize, rookSize, (bishopSize + rookSize) * 8 / 1024);
+    fprintf(file, "#pragma once\n\n");
+    fprintf(file, "#include \"BitOps.h\"\n\n");
+    fprintf(file, "// magic multipliers of the slider tables\n");
+    writeMagicArray(file, "bishopMagicNumbers", bishopJobs);
+    writeMagicArray(file, "rookMagicNumbers", rookJobs);
+    fprintf(file, "\n");
+    fprintf(file, "// index bits of each magic, fewer bits than the mask has means the magic\n");
+    fprintf(file, "// lets occupancies with identical attacks share a table entry\n");
+    writeBitCountArray(file, "bishopRelevantBitCount", bishopJobs);
+    fprintf(file, "\n");
+    writeBitCountArray(file, "rookRelevantBitCount", rookJobs);
+
+    fclose(file);
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    int threadCount = (int)std::thread::hardware_concurrency();
+    long long attempts = 1000000;
+    const char* outputPath = "MagicNumbers.h";
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "-t") && i + 1 < argc)
+            threadCount = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-n") && i + 1 < argc)
+            attempts = atoll(argv[++i]);
+        else if (!strcmp(argv[i], "-o") && i + 1 < argc)
+            outputPath = argv[++i];
+        else
+        {
+            printf("usage: %s [-t threads] [-n attempts per bit count] [-o file]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (threadCount < 1)
+        threadCount = 1;
+
+    // bishops in 0..63, rooks in 64..127
+    MagicJob jobs[128];
+    for (int i = 0; i < 128; ++i)
+    {
+        jobs[i].square = i % 64;
+        jobs[i].isBishop = i < 64;
+    }
+
+    // rooks take much longer, hand them out first so the bishops fill the gaps at the end
+    std::atomic<int> nextJob(0);
+    std::atomic<int> finishedJobs(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back([&]()
+        {
+            for (int i = nextJob++; i < 128; i = nextJob++)
+            {
+                MagicJob* job = &jobs[(i + 64) % 128];
+                runMagicJob(job, attempts);
+
+                printf("[%3d/128] %s %2d: %d bits 0x%llx\n", ++finishedJobs, job->isBishop ? "bishop" : "rook", job->square, job->bitCount, job->magicNumber);
+                fflush(stdout);
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+
+    if (!writeMagicHeader(outputPath, jobs, jobs + 64))
+    {
+        printf("cannot write %s\n", outputPath);
+        return 1;
+    }
+
+    int bishopSize = getTableSize(jobs);
+    int rookSize = getTableSize(jobs + 64);
+    printf("wrote %s: bishop %d entries, rook %d entries, %d KB\n", outputPath, bishopSize, rookSize, (bishopSize + rookSize) * 8 / 1024);
+    return 0;
+}
@@ -0,0 +1,309 @@
+#include "Board.h"
+#include "Evaluate.h"
+#include "Fen.h"
+#include "MovePicker.h"
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// times the Board core hot paths one function at a time, in nanoseconds per call
+//
+//   micro_bench [-r repetitions] [-w warmup] [-b magic|pext] [-filter name]
+//
+// every benchmark runs over the same openings, middlegames and endgames, first untimed to warm
+// caches and branch predictors, then timed per repetition; the spread between repetitions shows
+// how far apart two runs have to be before a difference means something
+
+static const char* benchFens[] = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+    "4rrk1/pp1n3p/3q2pQ/2p1pb2/2PP4/2P3N1/P2B2PP/4RRK1 b - - 7 19",
+    "r3r1k1/2p2ppp/p1p1bn2/8/1q2P3/2NPQN2/PPP3PP/R4RK1 b - - 2 15",
+    "r1bbk1nr/pp3p1p/2n5/1N4p1/2Np1B2/8/PPP2PPP/2KR1B1R w kq - 0 13",
+    "2rqkb1r/ppp2p2/2npb1p1/1N1Nn2p/2P1PP2/8/PP2B1PP/R1BQK2R b KQ - 0 11",
+    "3r1rk1/p5pp/bpp1pp2/8/q1PP1P2/b3P3/P2NQRPP/1R2B1K1 b - - 6 22",
+    "4k2r/1pb2ppp/1p2p3/1R1p4/3P4/2r1PN2/P4PPP/1R4K1 b - - 3 22",
+    "6k1/6p1/6Pp/ppp5/3pn2P/1P3K2/1PP2P2/8 b - - 0 1",
+    "8/8/1P6/5pr1/8/4R3/7k/2K5 w - - 0 1",
+    "8/R7/2q5/8/6k1/8/1P5p/K6R w - - 0 124",
+    "6k1/3b3r/1p1p4/p1n2p2/1PPNpP1q/P3Q1p1/1R1RB1P1/5K2 b - - 0 1",
+};
+
+static const int positionCount = sizeof(benchFens) / sizeof(benchFens[0]);
+static const int maxRepetitions = 100;
+
+static Board boards[positionCount];
+static U64 occupancies[positionCount * 64];
+static int squares[positionCount * 64];
+
+static int repetitionCount = 10;
+static int warmupCount = 3;
+static const char* nameFilter = nullptr;
+
+// keeps the compiler from dropping the work whose result nobody reads
+static U64 sink = 0ULL;
+
+// body runs one repetition and returns how many calls it made
+template <typename Body>
+static void runBenchmark(const char* name, Body body)
+{
+    if (nameFilter && !strstr(name, nameFilter))
+        return;
+
+    for (int i = 0; i < warmupCount; ++i)
+        body();
+
+    double samples[maxRepetitions] = {};
+    for (int i = 0; i < repetitionCount; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        long long calls = body();
+        auto end = std::chrono::steady_clock::now();
+        samples[i] = std::chrono::duration<double, std::nano>(end - start).count() / calls;
+    }
+
+    double mean = 0.0;
+    double best = samples[0];
+    for (int i = 0; i < repetitionCount; ++i)
+    {
+        mean += samples[i];
+        if (samples[i] < best)
+            best = samples[i];
+    }
+    mean /= repetitionCount;
+
+    double variance = 0.0;
+    for (int i = 0; i < repetitionCount; ++i)
+        variance += (samples[i] - mean) * (samples[i] - mean);
+    if (repetitionCount > 1)
+        variance /= repetitionCount - 1;
+    double deviation = sqrt(variance);
+
+    printf("%-28s %10.2f %10.2f %10.3f %7.2f%%\n", name, mean, best, deviation, 100.0 * deviation / mean);
+}
+
+// every slider lookup runs over all 64 squares of every position's occupancy, 2000 times per repetition
+static long long benchSliderLookup(U64 (*lookup)(U64, int))
+{
+    const int rounds = 2000;
+    U64 result = 0ULL;
+    for (int round = 0; round < rounds; ++round)
+        for (int i = 0; i < positionCount * 64; ++i)
+            result += lookup(occupancies[i], squares[i]);
+
+    sink += result;
+    return (long long)rounds * positionCount * 64;
+}
+
+int main(int argc, char** argv)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "-r") && i + 1 < argc)
+            repetitionCount = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-w") && i + 1 < argc)
+            warmupCount = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-filter") && i + 1 < argc)
+            nameFilter = argv[++i];
+        else if (!strcmp(argv[i], "-b") && i + 1 < argc)
+        {
+            const char* backend = argv[++i];
+            if (!setSliderBackend(strcmp(backend, "pext") ? magicBackend : pextBackend))
+            {
+                printf("this CPU has no BMI2 pext\n");
+                return 1;
+            }
+        }
+        else
+        {
+            printf("usage: %s [-r repetitions] [-w warmup] [-b magic|pext] [-filter name]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (repetitionCount < 1)
+        repetitionCount = 1;
+    if (repetitionCount > maxRepetitions)
+        repetitionCount = maxRepetitions;
+
+    for (int i = 0; i < positionCount; ++i)
+    {
+        boards[i].resetBoard();
+        if (!parseFEN(&boards[i], benchFens[i]))
+        {
+            printf("invalid FEN: %s\n", benchFens[i]);
+            return 1;
+        }
+
+        for (int square = 0; square < 64; ++square)
+        {
+            occupancies[i * 64 + square] = boards[i].getPosition().occupied[Board::both];
+            squares[i * 64 + square] = square;
+        }
+    }
+
+    printf("%s backend, %d positions, %d warmup + %d timed repetitions\n\n", sliderBackend == pextBackend ? "pext" : "magic",
+        positionCount, warmupCount, repetitionCount);
+    printf("%-28s %10s %10s %10s %8s\n", "function", "mean ns", "best ns", "stddev", "rsd");
+
+    runBenchmark("getRookAttackBitboard", []() { return benchSliderLookup(Board::getRookAttackBitboard); });
+    runBenchmark("getBishopAttackBitboard", []() { return benchSliderLookup(Board::getBishopAttackBitboard); });
+    runBenchmark("getQueenAttackBitboard", []() { return benchSliderLookup(Board::getQueenAttackBitboard); });
+
+    runBenchmark("isSquareAttacked", []()
+    {
+        const int rounds = 500;
+        U64 result = 0ULL;
+        for (int round = 0; round < rounds; ++round)
+            for (const Board& board : boards)
+                for (int square = 0; square < 64; ++square)
+                    result += board.isSquareAttacked(Board::white, square) + board.isSquareAttacked(Board::black, square);
+
+        sink += result;
+        return (long long)rounds * positionCount * 128;
+    });
+
+    runBenchmark("getSideAttacks", []()
+    {
+        const int rounds = 20000;
+        U64 result = 0ULL;
+        for (int round = 0; round < rounds; ++round)
+            for (const Board& board : boards)
+                result += board.getSideAttacks(Board::white) ^ board.getSideAttacks(Board::black);
+
+        sink += result;
+        return (long long)rounds * positionCount * 2;
+    });
+
+    runBenchmark("generateLegalMoves", []()
+    {
+        const int rounds = 20000;
+        U64 result = 0ULL;
+        for (int round = 0; round < rounds; ++round)
+        {
+            for (const Board& board : boards)
+            {
+                MoveList moveList;
+                board.generateLegalMoves(moveList);
+                result += moveList.size();
+            }
+        }
+
+        sink += result;
+        return (long long)rounds * positionCount;
+    });
+
+    runBenchmark("generatePseudoLegalMoves", []()
+    {
+        const int rounds = 20000;
+        U64 result = 0ULL;
+        for (int round = 0; round < rounds; ++round)
+        {
+            for (const Board& board : boards)
+            {
+                MoveList moveList;
+                board.generatePseudoLegalMoves(moveList);
+                result += moveList.size();
+            }
+        }
+
+        sink += result;
+        return (long long)rounds * positionCount;
+    });
+
+    runBenchmark("MovePicker", []()
+    {
+        static const ButterflyHistory history = {};
+        static const ContinuationHistory continuationHistory = {};
+        const Move killers[2] = { noMove, noMove };
+        const int rounds = 10000;
+        long long calls = 0;
+        for (int round = 0; round < rounds; ++round)
+        {
+            for (const Board& board : boards)
+            {
+                const PieceToHistory* continuations[2] = { &continuationHistory[Board::whitePawn][0], &continuationHistory[Board::blackPawn][0] };
+                MovePicker picker(board, noMove, killers, noMove, history, continuations);
+                for (Move move = picker.next(); move != noMove; move = picker.next())
+                    sink += move;
+                calls++;
+            }
+        }
+        return calls;
+    });
+
+    runBenchmark("makeMove+unmakeMove", []()
+    {
+        const int rounds = 2000;
+        long long calls = 0;
+        for (Board& board : boards)
+        {
+            MoveList moveList;
+            board.generateLegalMoves(moveList);
+            for (int round = 0; round < rounds; ++round)
+            {
+                for (Move move : moveList)
+                {
+                    board.makeMove(move);
+                    sink += board.getKey();
+                    board.unmakeMove();
+                }
+            }
+            calls += (long long)rounds * moveList.size();
+        }
+        return calls;
+    });
+
+    runBenchmark("see", []()
+    {
+        const int rounds = 5000;
+        long long calls = 0;
+        for (const Board& board : boards)
+        {
+            MoveList captures;
+            board.generatePseudoLegalMoves(captures, captureMoves);
+            for (int round = 0; round < rounds; ++round)
+                for (Move move : captures)
+                    sink += board.see(move);
+            calls += (long long)rounds * captures.size();
+        }
+        return calls;
+    });
+
+    runBenchmark("evaluate", []()
+    {
+        const int rounds = 50000;
+        long long result = 0;
+        for (int round = 0; round < rounds; ++round)
+            for (const Board& board : boards)
+                result += evaluate(board);
+
+        sink += result;
+        return (long long)rounds * positionCount;
+    });
+
+    runBenchmark("resetBoard+parseFEN", []()
+    {
+        static Board board;
+        const int rounds = 5000;
+        for (int round = 0; round < rounds; ++round)
+        {
+            for (const char* fen : benchFens)
+            {
+                board.resetBoard();
+                parseFEN(&board, fen);
+                sink += board.getKey();
+            }
+        }
+        return (long long)rounds * positionCount;
+    });
+
+    printf("\n(checksum %llx)\n", sink);
+    return 0;
+}
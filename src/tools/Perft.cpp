@@ -0,0 +1,483 @@
+#include "Board.h"
+#include "Fen.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+// counts the leaf nodes of the legal move tree to a fixed depth and checks them against
+// the well known results, the standard test for move generation and make/unmake
+//
+// deep counts are split over a thread pool at the second ply and share a lock-free hash table
+// of subtree counts keyed by the Zobrist key and the remaining depth
+
+struct PerftPosition
+{
+    const char* name;
+    const char* fen;
+    // expected node counts for depth 1, 2, ..., zero terminated
+    U64 nodes[8];
+    // depth the suite runs by default
+    int depth;
+};
+
+static const PerftPosition perftSuite[] = {
+    { "startpos", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        { 20, 400, 8902, 197281, 4865609, 119060324 }, 6 },
+    { "kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        { 48, 2039, 97862, 4085603, 193690690 }, 5 },
+    { "position 3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        { 14, 191, 2812, 43238, 674624, 11030083, 178633661 }, 6 },
+    { "position 4", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        { 6, 264, 9467, 422333, 15833292, 706045033 }, 5 },
+    { "position 5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        { 44, 1486, 62379, 2103487, 89941194 }, 5 },
+    { "position 6", "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+        { 46, 2079, 89890, 3894594, 164075551 }, 5 },
+};
+
+// workers stay alive between runs, run() hands every worker the same task and waits for all of them
+class ThreadPool
+{
+public:
+    explicit ThreadPool(int threadCount)
+    {
+        for (int i = 0; i < threadCount; ++i)
+            m_threads.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_quit = true;
+        }
+        m_wake.notify_all();
+        for (std::thread& thread : m_threads)
+            thread.join();
+    }
+
+    int size() const { return (int)m_threads.size(); }
+
+    void run(const std::function<void(int)>& task)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_task = &task;
+        m_running = size();
+        m_generation++;
+        m_wake.notify_all();
+        m_done.wait(lock, [this]() { return m_running == 0; });
+        m_task = nullptr;
+    }
+
+private:
+    void workerLoop(int index)
+    {
+        int seenGeneration = 0;
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true)
+        {
+            m_wake.wait(lock, [&]() { return m_quit || m_generation != seenGeneration; });
+            if (m_quit)
+                return;
+            seenGeneration = m_generation;
+
+            lock.unlock();
+            (*m_task)(index);
+            lock.lock();
+
+            if (--m_running == 0)
+                m_done.notify_one();
+        }
+    }
+
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    const std::function<void(int)>* m_task = nullptr;
+    int m_generation = 0;
+    int m_running = 0;
+    bool m_quit = false;
+};
+
+// the data word holds the count above the depth, the check word is the key xor the data so a
+// torn write from two threads storing to the same slot fails verification instead of being trusted
+struct PerftEntry
+{
+    std::atomic<U64> check;
+    std::atomic<U64> data;
+};
+
+class PerftTable
+{
+public:
+    void resize(int megabytes)
+    {
+        U64 count = 0;
+        if (megabytes > 0)
+        {
+            count = 1;
+            while (count * 2 * sizeof(PerftEntry) <= (U64)megabytes << 20)
+                count *= 2;
+        }
+        m_entries.reset(count ? new PerftEntry[count] : nullptr);
+        m_mask = count - 1;
+        clear();
+    }
+
+    void clear()
+    {
+        for (U64 i = 0; m_entries && i <= m_mask; ++i)
+        {
+            m_entries[i].check.store(0, std::memory_order_relaxed);
+            m_entries[i].data.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    bool isEnabled() const { return m_entries != nullptr; }
+
+    bool probe(U64 key, int depth, U64* nodes) const
+    {
+        const PerftEntry& entry = m_entries[getIndex(key, depth)];
+        U64 data = entry.data.load(std::memory_order_relaxed);
+        U64 check = entry.check.load(std::memory_order_relaxed);
+        if ((check ^ data) != key || (int)(data & 0xff) != depth)
+            return false;
+
+        *nodes = data >> 8;
+        return true;
+    }
+
+    void store(U64 key, int depth, U64 nodes)
+    {
+        PerftEntry& entry = m_entries[getIndex(key, depth)];
+        U64 data = nodes << 8 | (U64)depth;
+        entry.check.store(key ^ data, std::memory_order_relaxed);
+        entry.data.store(data, std::memory_order_relaxed);
+    }
+
+private:
+    // the same position at another depth lands in another slot instead of evicting it
+    U64 getIndex(U64 key, int depth) const { return (key ^ ((U64)depth * 0x9e3779b97f4a7c15ULL)) & m_mask; }
+
+    std::unique_ptr<PerftEntry[]> m_entries;
+    U64 m_mask = 0;
+};
+
+static PerftTable perftTable;
+
+static U64 perft(Board& board, int depth, bool bulk)
+{
+    if (depth == 0)
+        return 1;
+
+    MoveList moveList;
+    board.generateLegalMoves(moveList);
+
+    // the legal move count is the leaf count one ply up, no need to play the last moves
+    if (bulk && depth == 1)
+        return moveList.size();
+
+    // below depth 2 a lookup costs about as much as the count itself
+    U64 nodes = 0;
+    bool isHashed = depth >= 2 && perftTable.isEnabled();
+    if (isHashed && perftTable.probe(board.getKey(), depth, &nodes))
+        return nodes;
+
+    for (Move move : moveList)
+    {
+        board.makeMove(move);
+        nodes += perft(board, depth - 1, bulk);
+        board.unmakeMove();
+    }
+
+    if (isHashed)
+        perftTable.store(board.getKey(), depth, nodes);
+
+    return nodes;
+}
+
+// one subtree two plies below the root, small enough that the threads finish close together
+struct PerftJob
+{
+    int rootIndex;
+    Move reply;
+};
+
+// counts every root move's subtree on the pool, rootNodes receives the per move counts for divide
+static U64 parallelPerft(Board& board, int depth, bool bulk, ThreadPool& pool, const MoveList& rootMoves,
+    std::vector<U64>& rootNodes)
+{
+    rootNodes.assign(rootMoves.size(), 0);
+
+    // too shallow to be worth splitting
+    if (depth < 3 || pool.size() == 1)
+    {
+        U64 nodes = 0;
+        for (int i = 0; i < rootMoves.size(); ++i)
+        {
+            board.makeMove(rootMoves[i]);
+            rootNodes[i] = perft(board, depth - 1, bulk);
+            board.unmakeMove();
+            nodes += rootNodes[i];
+        }
+        return nodes;
+    }
+
+    // a root move without replies is mate or stalemate and adds nothing at this depth
+    std::vector<PerftJob> jobs;
+    for (int i = 0; i < rootMoves.size(); ++i)
+    {
+        MoveList replies;
+        board.makeMove(rootMoves[i]);
+        board.generateLegalMoves(replies);
+        board.unmakeMove();
+
+        for (Move reply : replies)
+            jobs.push_back({ i, reply });
+    }
+
+    std::vector<std::atomic<U64>> counts(rootMoves.size());
+    for (std::atomic<U64>& count : counts)
+        count = 0;
+
+    std::atomic<int> nextJob(0);
+    pool.run([&](int)
+    {
+        Board threadBoard = board;
+        for (int i = nextJob++; i < (int)jobs.size(); i = nextJob++)
+        {
+            const PerftJob& job = jobs[i];
+            threadBoard.makeMove(rootMoves[job.rootIndex]);
+            threadBoard.makeMove(job.reply);
+            counts[job.rootIndex] += perft(threadBoard, depth - 2, bulk);
+            threadBoard.unmakeMove();
+            threadBoard.unmakeMove();
+        }
+    });
+
+    U64 nodes = 0;
+    for (int i = 0; i < rootMoves.size(); ++i)
+    {
+        rootNodes[i] = counts[i];
+        nodes += rootNodes[i];
+    }
+    return nodes;
+}
+
+static U64 runPerft(Board& board, int depth, bool bulk, ThreadPool& pool, bool isDivide)
+{
+    MoveList rootMoves;
+    board.generateLegalMoves(rootMoves);
+
+    std::vector<U64> rootNodes;
+    U64 nodes = parallelPerft(board, depth, bulk, pool, rootMoves, rootNodes);
+
+    if (isDivide)
+    {
+        for (int i = 0; i < rootMoves.size(); ++i)
+        {
+            char moveString[6];
+            getMoveString(rootMoves[i], moveString);
+            printf("%-5s %llu\n", moveString, rootNodes[i]);
+        }
+        printf("\nmoves %d\n", rootMoves.size());
+    }
+
+    return nodes;
+}
+
+static bool setupBoard(Board& board, const char* fen)
+{
+    board.resetBoard();
+    if (!parseFEN(&board, fen))
+    {
+        printf("invalid FEN: %s\n", fen);
+        return false;
+    }
+    return true;
+}
+
+// runs the suite, depth 0 uses each position's default; returns the nodes per second over all positions
+static double runSuite(int maxDepth, bool bulk, ThreadPool& pool, int* failures)
+{
+    Board board;
+    U64 totalNodes = 0;
+    double totalSeconds = 0.0;
+
+    for (const PerftPosition& position : perftSuite)
+    {
+        int depth = maxDepth ? maxDepth : position.depth;
+        while (depth > 1 && position.nodes[depth - 1] == 0)
+            depth--;
+
+        setupBoard(board, position.fen);
+        perftTable.clear();
+
+        auto start = std::chrono::steady_clock::now();
+        U64 nodes = runPerft(board, depth, bulk, pool, false);
+        auto end = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(end - start).count();
+
+        bool passed = nodes == position.nodes[depth - 1];
+        if (!passed)
+            (*failures)++;
+
+        printf("%-12s depth %d %12llu nodes %6.2f s %7.1f Mnps  %s\n", position.name, depth, nodes, seconds,
+            nodes / seconds / 1e6, passed ? "ok" : "FAILED");
+
+        totalNodes += nodes;
+        totalSeconds += seconds;
+    }
+
+    double nps = totalNodes / totalSeconds;
+    printf("%-12s         %12llu nodes %6.2f s %7.1f Mnps\n", "total", totalNodes, totalSeconds, nps / 1e6);
+    return nps;
+}
+
+// times one position at 1, 2, 4, ... threads, each run starting from an empty hash table
+static void runScaling(Board& board, int depth, bool bulk, int maxThreads)
+{
+    double baseSeconds = 0.0;
+    for (int threadCount = 1; ; threadCount = threadCount * 2 < maxThreads ? threadCount * 2 : maxThreads)
+    {
+        ThreadPool pool(threadCount);
+        perftTable.clear();
+
+        auto start = std::chrono::steady_clock::now();
+        U64 nodes = runPerft(board, depth, bulk, pool, false);
+        auto end = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(end - start).count();
+        if (threadCount == 1)
+            baseSeconds = seconds;
+
+        printf("threads %3d %12llu nodes %7.2f s %8.1f Mnps  speedup %5.2f\n", threadCount, nodes, seconds,
+            nodes / seconds / 1e6, baseSeconds / seconds);
+
+        if (threadCount == maxThreads)
+            break;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const char* fen = nullptr;
+    const char* backend = "auto";
+    int depth = 0;
+    int threadCount = (int)std::thread::hardware_concurrency();
+    int hashMegabytes = 64;
+    bool isDivide = false;
+    bool isScaling = false;
+    bool bulk = true;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "-d") && i + 1 < argc)
+            depth = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-f") && i + 1 < argc)
+            fen = argv[++i];
+        else if (!strcmp(argv[i], "-b") && i + 1 < argc)
+            backend = argv[++i];
+        else if (!strcmp(argv[i], "-t") && i + 1 < argc)
+            threadCount = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-hash") && i + 1 < argc)
+            hashMegabytes = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-scale"))
+            isScaling = true;
+        else if (!strcmp(argv[i], "-divide"))
+            isDivide = true;
+        else if (!strcmp(argv[i], "-nobulk"))
+            bulk = false;
+        else
+        {
+            printf("usage: %s [-f fen] [-d depth] [-divide] [-nobulk] [-b auto|magic|pext|all] [-t threads] [-hash MB] [-scale]\n", argv[0]);
+            printf("  without -f runs the standard suite and checks the node counts\n");
+            printf("  -b all runs the suite once per slider backend to compare their speed\n");
+            printf("  -hash 0 turns the shared perft hash table off\n");
+            printf("  -scale times the -f position (kiwipete by default) from 1 up to -t threads\n");
+            return 1;
+        }
+    }
+    if (threadCount < 1)
+        threadCount = 1;
+    if (depth < 0)
+        depth = 0;
+
+    perftTable.resize(hashMegabytes);
+
+    if (!strcmp(backend, "magic"))
+        setSliderBackend(magicBackend);
+    else if (!strcmp(backend, "pext") && !setSliderBackend(pextBackend))
+    {
+        printf("this CPU has no BMI2 pext\n");
+        return 1;
+    }
+
+    if (isScaling)
+    {
+        Board board;
+        if (!setupBoard(board, fen ? fen : perftSuite[1].fen))
+            return 1;
+
+        runScaling(board, depth ? depth : 5, bulk, threadCount);
+        return 0;
+    }
+
+    ThreadPool pool(threadCount);
+
+    // a single position
+    if (fen)
+    {
+        Board board;
+        if (!setupBoard(board, fen))
+            return 1;
+        if (depth < 1)
+            depth = 5;
+
+        auto start = std::chrono::steady_clock::now();
+        U64 nodes = runPerft(board, depth, bulk, pool, isDivide);
+        auto end = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(end - start).count();
+
+        printf("nodes %llu  %.2f s  %.1f Mnps\n", nodes, seconds, nodes / seconds / 1e6);
+        return 0;
+    }
+
+    int failures = 0;
+    if (!strcmp(backend, "all"))
+    {
+        setSliderBackend(magicBackend);
+        printf("magic backend\n");
+        double magicNps = runSuite(depth, bulk, pool, &failures);
+
+        if (setSliderBackend(pextBackend))
+        {
+            printf("\npext backend\n");
+            double pextNps = runSuite(depth, bulk, pool, &failures);
+            printf("\npext/magic speed ratio %.2f\n", pextNps / magicNps);
+        }
+        else
+        {
+            printf("\nthis CPU has no BMI2 pext, skipping the pext backend\n");
+        }
+    }
+    else
+    {
+        printf("%s backend\n", sliderBackend == pextBackend ? "pext" : "magic");
+        runSuite(depth, bulk, pool, &failures);
+    }
+
+    if (failures)
+        printf("\n%d position(s) FAILED\n", failures);
+
+    return failures ? 1 : 0;
+}
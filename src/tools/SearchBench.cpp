@@ -0,0 +1,22 @@
+#include "Bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+// fixed depth search over the bench positions, the printed node count is the signature to compare
+// between commits and the nodes per second the speed
+//
+//   bench [depth]
+
+int main(int argc, char** argv)
+{
+    int depth = defaultBenchDepth;
+    if (argc > 2 || (argc == 2 && (depth = atoi(argv[1])) < 1))
+    {
+        printf("usage: %s [depth]\n", argv[0]);
+        return 1;
+    }
+
+    runBench(depth);
+    return 0;
+}
@@ -0,0 +1,135 @@
+#include "Board.h"
+#include "SetwiseAttacks.h"
+
+#include <chrono>
+#include <stdio.h>
+
+// times slider attack lookups for every backend this CPU can run, then whole-side slider
+// attacks from per-square lookups against the setwise Kogge-Stone fills
+
+static const int sampleCount = 1 << 16;
+static const int roundCount = 200;
+
+static U64 occupancies[sampleCount];
+static int squares[sampleCount];
+static U64 rooksQueens[sampleCount];
+static U64 bishopsQueens[sampleCount];
+
+static U64 getRandomU64()
+{
+    static U64 state = 1070372ULL;
+
+    // xorshift64*
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 2685821657736338717ULL;
+}
+
+// returns lookups per second, sink keeps the compiler from dropping the loop
+static double timeLookups(U64 (*lookup)(U64, int), U64* sink)
+{
+    U64 result = 0ULL;
+
+    // warm up caches and branch predictors
+    for (int i = 0; i < sampleCount; ++i)
+        result += lookup(occupancies[i], squares[i]);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < roundCount; ++round)
+        for (int i = 0; i < sampleCount; ++i)
+            result += lookup(occupancies[i], squares[i]);
+    auto end = std::chrono::steady_clock::now();
+
+    *sink += result;
+    double seconds = std::chrono::duration<double>(end - start).count();
+    return (double)sampleCount * roundCount / seconds;
+}
+
+// picks up to count random occupied squares
+static U64 pickPieces(U64 occ, int count)
+{
+    U64 pieces = 0ULL;
+    for (int i = 0; i < count; ++i)
+        pieces |= occ & (1ULL << (getRandomU64() % 64));
+    return pieces;
+}
+
+static U64 getSliderAttacksPerSquare(U64 rooks, U64 bishops, U64 occ)
+{
+    U64 attacks = 0ULL;
+
+    while (rooks)
+        attacks |= Board::getRookAttackBitboard(occ, popLSB(rooks));
+    while (bishops)
+        attacks |= Board::getBishopAttackBitboard(occ, popLSB(bishops));
+
+    return attacks;
+}
+
+// returns piece sets per second
+static double timeSideAttacks(U64 (*sideAttacks)(U64, U64, U64), U64* sink)
+{
+    U64 result = 0ULL;
+
+    for (int i = 0; i < sampleCount; ++i)
+        result += sideAttacks(rooksQueens[i], bishopsQueens[i], occupancies[i]);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < roundCount; ++round)
+        for (int i = 0; i < sampleCount; ++i)
+            result += sideAttacks(rooksQueens[i], bishopsQueens[i], occupancies[i]);
+    auto end = std::chrono::steady_clock::now();
+
+    *sink += result;
+    double seconds = std::chrono::duration<double>(end - start).count();
+    return (double)sampleCount * roundCount / seconds;
+}
+
+int main(int, char**)
+{
+    // about a quarter of the squares occupied, like a middlegame position
+    for (int i = 0; i < sampleCount; ++i)
+    {
+        occupancies[i] = getRandomU64() & getRandomU64();
+        squares[i] = (int)(getRandomU64() % 64);
+
+        // two rooks, two bishops and a queen at most, the queen goes into both sets
+        U64 queens = pickPieces(occupancies[i], 1);
+        rooksQueens[i] = pickPieces(occupancies[i], 2) | queens;
+        bishopsQueens[i] = pickPieces(occupancies[i], 2) | queens;
+    }
+
+    const char* backendNames[] = { "magic", "pext" };
+    printf("default backend: %s\n\n", backendNames[sliderBackend]);
+    printf("%-8s %14s %14s %14s\n", "backend", "rook Mlook/s", "bishop Mlook/s", "queen Mlook/s");
+
+    U64 sink = 0ULL;
+    SliderBackend defaultBackend = sliderBackend;
+    const SliderBackend backends[] = { magicBackend, pextBackend };
+    for (SliderBackend backend : backends)
+    {
+        if (!setSliderBackend(backend))
+        {
+            printf("%-8s not supported on this CPU\n", backendNames[backend]);
+            continue;
+        }
+
+        double rook = timeLookups(Board::getRookAttackBitboard, &sink);
+        double bishop = timeLookups(Board::getBishopAttackBitboard, &sink);
+        double queen = timeLookups(Board::getQueenAttackBitboard, &sink);
+        printf("%-8s %14.1f %14.1f %14.1f\n", backendNames[backend], rook / 1e6, bishop / 1e6, queen / 1e6);
+    }
+    setSliderBackend(defaultBackend);
+
+    printf("\n%-24s %14s\n", "side slider attacks", "Msets/s");
+    printf("%-24s %14.1f\n", "per-square lookups", timeSideAttacks(getSliderAttacksPerSquare, &sink) / 1e6);
+    printf("%-24s %14.1f\n", "setwise scalar", timeSideAttacks(getSliderAttacksSetwiseScalar, &sink) / 1e6);
+    if (cpuHasAvx2())
+        printf("%-24s %14.1f\n", "setwise avx2", timeSideAttacks(getSliderAttacksSetwiseAvx2, &sink) / 1e6);
+    else
+        printf("%-24s not supported on this CPU\n", "setwise avx2");
+
+    printf("\n(checksum %llx)\n", sink);
+    return 0;
+}